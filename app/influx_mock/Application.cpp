@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Application.hpp"
+#include <cmath>
+#include <iostream>
+#include <signal.h>
+#include <time.h>
+
+Application::Application(Parameters const& par) : par_(par) {
+  // block termination signals, they are consumed in run()
+  sigset_t sigset;
+  sigemptyset(&sigset);
+  sigaddset(&sigset, SIGINT);
+  sigaddset(&sigset, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+
+  // start up server, threads inherit the blocked signal mask ----
+  mock_ = std::make_unique<cbm::MonitorInfluxMock>(par.port);
+  mock_->SetLatency(par.latency);
+  mock_->SetErrorStatus(par.error_status, par.error_rate);
+  mock_->SetResetRate(par.reset_rate);
+  mock_->SetMaxBody(par.max_body);
+  mock_->SetSeed(par.seed);
+}
+
+void Application::run() {
+  std::cout << "listening on 127.0.0.1:" << mock_->Port() << std::endl;
+
+  sigset_t sigset;
+  sigemptyset(&sigset);
+  sigaddset(&sigset, SIGINT);
+  sigaddset(&sigset, SIGTERM);
+  double isec = 0.;
+  double fsec = std::modf(par_.interval, &isec);
+  timespec timeout{time_t(isec), long(fsec * 1.e9)};
+
+  auto last = mock_->Statistics();
+  while (true) {
+    int sig = sigtimedwait(&sigset, nullptr, &timeout);
+    auto stats = mock_->Statistics();
+    std::cout << "requests " << stats.fNRequest << " (+"
+              << stats.fNRequest - last.fNRequest << ")"
+              << "  lines " << stats.fNLine << " (+"
+              << stats.fNLine - last.fNLine << ")"
+              << "  bytes " << stats.fNByte << "  bad " << stats.fNBadLine
+              << "  errors " << stats.fNError << "  resets "
+              << stats.fNReset << "  connections " << stats.fNConn
+              << std::endl;
+    last = stats;
+    if (sig > 0)
+      break;
+  }
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Parameters.hpp"
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+Parameters::Parameters(int argc, char* argv[]) {
+  po::options_description generic("Generic options");
+  auto generic_add = generic.add_options();
+  generic_add("help,h", "display this help and exit");
+  generic_add("port,p", po::value<int>(&port)->default_value(port),
+              "port to listen on (loopback only)");
+  generic_add("interval,i",
+              po::value<double>(&interval)->default_value(interval),
+              "statistics print interval (in s)");
+
+  po::options_description fault("Fault injection options");
+  auto fault_add = fault.add_options();
+  fault_add("latency", po::value<double>(&latency)->default_value(latency),
+            "delay of each response (in s)");
+  fault_add("status",
+            po::value<unsigned>(&error_status)->default_value(error_status),
+            "HTTP status of injected error responses");
+  fault_add("error-rate",
+            po::value<double>(&error_rate)->default_value(error_rate),
+            "probability of an injected error response");
+  fault_add("reset-rate",
+            po::value<double>(&reset_rate)->default_value(reset_rate),
+            "probability of an injected connection reset");
+  fault_add("max-body", po::value<size_t>(&max_body)->default_value(max_body),
+            "respond 413 for larger bodies (in bytes, 0 for no limit)");
+  fault_add("seed", po::value<unsigned>(&seed)->default_value(seed),
+            "seed of the fault injection random generator");
+
+  po::options_description cmdline_options("Allowed options");
+  cmdline_options.add(generic).add(fault);
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, cmdline_options), vm);
+  po::notify(vm);
+
+  if (vm.count("help") != 0u) {
+    std::cout << "mock InfluxDB server"
+              << "\n";
+    std::cout << cmdline_options << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+}
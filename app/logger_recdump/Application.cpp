@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Application.hpp"
+#include "ChronoHelper.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+// severity names in the order of Logger::LoggerSeverityLevel
+static const char* const severity_names[] = {
+    "Trace", "Debug", "Info", "Note", "Warning", "Error", "Fatal"};
+
+Application::Application(Parameters const& par) : par_(par) {
+  auto it = std::find(std::begin(severity_names), std::end(severity_names),
+                      par.severity);
+  if (it == std::end(severity_names))
+    throw ParametersException("invalid severity " + par.severity);
+  min_severity_ = int(it - std::begin(severity_names));
+
+  recorder_ = std::make_unique<cbm::LoggerRecorder>(par.file);
+  if (!par.output.empty()) {
+    ofile_ = std::make_unique<std::ofstream>(par.output, std::ios::app);
+    if (!ofile_->is_open())
+      throw ParametersException("can't open output file " + par.output);
+  }
+}
+
+void Application::run() {
+  std::ostream& os = ofile_ ? *ofile_ : std::cout;
+  std::vector<cbm::LoggerMessage> msgvec;
+  recorder_->Snapshot(msgvec);
+
+  // same line format as LoggerSinkFile
+  std::string host = recorder_->HostName();
+  std::string line;
+  size_t nprint = 0;
+  for (auto& msg : msgvec) {
+    if (msg.fSevId < min_severity_)
+      continue;
+    line.clear();
+    cbm::AppendTimePoint(line, msg.fTime);
+    line += ": {host=";
+    line += host;
+    line += ",thread=";
+    line += msg.fThreadName;
+    line += ",sev=";
+    if (msg.fSevId >= 0 && msg.fSevId < int(std::size(severity_names)))
+      line += severity_names[msg.fSevId];
+    else
+      line += std::to_string(msg.fSevId);
+    if (msg.fKeysSize) {
+      line += ',';
+      line += msg.Keys();
+    }
+    line += "}: ";
+    line += msg.Message();
+    line += '\n';
+    os.write(line.data(), std::streamsize(line.size()));
+    nprint += 1;
+  }
+  os.flush();
+
+  if (par_.stats) {
+    std::cerr << "recorder " << recorder_->Path() << ": writer "
+              << recorder_->ProgName() << " pid " << recorder_->WriterPid()
+              << " on " << host << ", slots " << recorder_->NSlot()
+              << ", records " << recorder_->NRecord() << ", decoded "
+              << msgvec.size() << ", printed " << nprint << "\n";
+  }
+}
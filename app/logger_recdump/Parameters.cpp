@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Parameters.hpp"
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+Parameters::Parameters(int argc, char* argv[]) {
+  po::options_description generic("Generic options");
+  auto generic_add = generic.add_options();
+  generic_add("help,h", "display this help and exit");
+  generic_add("file,f", po::value<std::string>(&file)->value_name("<file>"),
+              "flight recorder file, as given to Logger::OpenRecorder()");
+  generic_add("output,o", po::value<std::string>(&output)->value_name("<file>"),
+              "append lines to <file> instead of stdout");
+  generic_add("severity,l",
+              po::value<std::string>(&severity)->default_value(severity),
+              "lowest severity to print, Trace to Fatal");
+  generic_add("stats,s", po::bool_switch(&stats),
+              "print recorder statistics to stderr at exit");
+
+  po::positional_options_description positional;
+  positional.add("file", 1);
+
+  po::options_description cmdline_options("Allowed options");
+  cmdline_options.add(generic);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(cmdline_options)
+                .positional(positional)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help") != 0u) {
+    std::cout << "logger flight recorder decoder"
+              << "\n";
+    std::cout << cmdline_options << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+  if (file.empty())
+    throw ParametersException("no recorder file given");
+}
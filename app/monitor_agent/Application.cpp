@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Application.hpp"
+#include "Exception.hpp"
+#include "MetricCodec.hpp"
+#include "SysCallException.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+constexpr size_t kLenSize = sizeof(uint32_t); // size of frame length word
+constexpr size_t kMaxFrame = 64 << 20;        // larger frames are rejected
+constexpr size_t kReadSize = 1 << 20;         // bytes per read call
+} // namespace
+
+Application::Application(Parameters const& par) : par_(par) {
+  // handle SIGINT and SIGTERM via a signalfd in the poll loop; block them
+  // before the Monitor thread is started, which inherits the mask
+  sigset_t sigset;
+  sigemptyset(&sigset);
+  sigaddset(&sigset, SIGINT);
+  sigaddset(&sigset, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+  int sfd = ::signalfd(-1, &sigset, SFD_CLOEXEC);
+  if (sfd < 0)
+    throw cbm::SysCallException("Application::ctor", "signalfd", errno);
+  signal_fd_.Set(sfd);
+
+  monitor_ = std::make_unique<cbm::Monitor>();
+  for (auto& uri : par.monitor_uris)
+    monitor_->OpenSink(uri);
+
+  sockaddr_un addr{};
+  if (par.socket.empty() || par.socket.size() >= sizeof(addr.sun_path))
+    throw ParametersException("socket path empty or too long");
+  addr.sun_family = AF_UNIX;
+  par.socket.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    throw cbm::SysCallException("Application::ctor", "socket", errno);
+  listen_fd_.Set(fd);
+  (void)::unlink(par.socket.c_str()); // remove stale socket of old agent
+  if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) <
+      0)
+    throw cbm::SysCallException("Application::ctor", "bind", par.socket,
+                                errno);
+  if (::listen(listen_fd_, SOMAXCONN) < 0)
+    throw cbm::SysCallException("Application::ctor", "listen", errno);
+}
+
+Application::~Application() {
+  (void)::unlink(par_.socket.c_str());
+  for (auto& kv : clients_)
+    (void)::close(kv.first);
+}
+
+void Application::run() {
+  using clock = std::chrono::steady_clock;
+  auto seconds = [](double sec) {
+    return std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(sec));
+  };
+  auto next_agg = clock::now() + seconds(par_.aggregate);
+  auto next_stats = clock::now() + seconds(par_.stats);
+
+  std::vector<pollfd> pollfds;
+  while (true) {
+    pollfds.clear();
+    pollfds.push_back({signal_fd_, POLLIN, 0});
+    pollfds.push_back({listen_fd_, POLLIN, 0});
+    for (auto& kv : clients_)
+      pollfds.push_back({kv.first, POLLIN, 0});
+
+    auto next = clock::time_point::max();
+    if (par_.aggregate > 0.)
+      next = std::min(next, next_agg);
+    if (par_.stats > 0.)
+      next = std::min(next, next_stats);
+    int timeout = -1;
+    if (next != clock::time_point::max()) {
+      auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+          next - clock::now());
+      timeout = int(std::max(0L, long(wait.count()) + 1));
+    }
+
+    if (::poll(pollfds.data(), pollfds.size(), timeout) < 0 && errno != EINTR)
+      throw cbm::SysCallException("Application::run", "poll", errno);
+    if (pollfds[0].revents)
+      break;
+    if (pollfds[1].revents & POLLIN)
+      accept_clients();
+    for (size_t i = 2; i < pollfds.size(); i++) {
+      if (!pollfds[i].revents)
+        continue;
+      int fd = pollfds[i].fd;
+      if (!read_client(fd, clients_[fd])) {
+        (void)::close(fd);
+        clients_.erase(fd);
+      }
+    }
+
+    auto now = clock::now();
+    if (par_.aggregate > 0. && now >= next_agg) {
+      flush_aggregate();
+      next_agg = now + seconds(par_.aggregate);
+    }
+    if (par_.stats > 0. && now >= next_stats) {
+      queue_stats();
+      next_stats = now + seconds(par_.stats);
+    }
+  }
+
+  // forward what is aggregated, the Monitor destructor sends the rest
+  flush_aggregate();
+}
+
+void Application::accept_clients() {
+  while (true) {
+    int fd = ::accept4(listen_fd_, nullptr, nullptr,
+                       SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+      return; // EAGAIN when all pending connections are accepted
+    clients_.try_emplace(fd);
+    stat_clients_ += 1;
+  }
+}
+
+// Reads what is available and forwards all complete frames. Returns false
+// when the connection was closed or sent an invalid frame; an incomplete
+// last frame is then discarded, the sink resends it after reconnect.
+bool Application::read_client(int fd, Client& client) {
+  std::vector<cbm::Metric> metvec;
+  bool open = true;
+  while (open) {
+    size_t nold = client.buf.size();
+    client.buf.resize(nold + kReadSize);
+    ssize_t nread = ::read(fd, client.buf.data() + nold, kReadSize);
+    client.buf.resize(nold + size_t(std::max(nread, ssize_t(0))));
+    if (nread == 0)
+      open = false;
+    if (nread <= 0) {
+      if (nread < 0 && errno == EINTR)
+        continue;
+      if (nread < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        open = false;
+      break;
+    }
+    stat_bytes_ += nread;
+    if (size_t(nread) < kReadSize)
+      break;
+  }
+
+  size_t pos = 0;
+  try {
+    while (client.buf.size() - pos >= kLenSize) {
+      uint32_t len = 0;
+      std::memcpy(&len, client.buf.data() + pos, kLenSize);
+      if (len > kMaxFrame)
+        throw cbm::Exception("frame too large");
+      if (client.buf.size() - pos - kLenSize < len)
+        break;
+      cbm::MetricDecode(
+          std::string_view(client.buf.data() + pos + kLenSize, len), metvec);
+      pos += kLenSize + len;
+      stat_frames_ += 1;
+    }
+  } catch (cbm::Exception const& e) {
+    std::cerr << "monitor_agent: dropping client: " << e.what() << "\n";
+    stat_errors_ += 1;
+    open = false;
+  }
+  client.buf.erase(0, pos);
+  forward(metvec);
+  return open;
+}
+
+// Forwards the points to the Monitor, or merges them into the aggregate.
+void Application::forward(std::vector<cbm::Metric>& metvec) {
+  stat_points_ += long(metvec.size());
+  if (par_.aggregate <= 0.) {
+    for (auto& met : metvec)
+      monitor_->QueueMetric(std::move(met));
+    stat_forwarded_ += long(metvec.size());
+    return;
+  }
+
+  for (auto& met : metvec) {
+    std::string key = met.fMeasurement;
+    for (auto& tag : met.fTagset)
+      key += '\0' + tag.first + '\0' + tag.second;
+    auto [it, isnew] = agg_index_.try_emplace(key, agg_.size());
+    if (isnew) {
+      agg_.push_back(std::move(met));
+      continue;
+    }
+    cbm::Metric& agg = agg_[it->second];
+    agg.fTimestamp = std::max(agg.fTimestamp, met.fTimestamp);
+    for (auto& field : met.fFieldset) {
+      auto pfield = std::find_if(
+          agg.fFieldset.begin(), agg.fFieldset.end(),
+          [&field](auto const& f) { return f.first == field.first; });
+      if (pfield != agg.fFieldset.end())
+        pfield->second = std::move(field.second);
+      else
+        agg.fFieldset.push_back(std::move(field));
+    }
+  }
+}
+
+void Application::flush_aggregate() {
+  for (auto& met : agg_)
+    monitor_->QueueMetric(std::move(met));
+  stat_forwarded_ += long(agg_.size());
+  agg_.clear();
+  agg_index_.clear();
+}
+
+void Application::queue_stats() {
+  monitor_->QueueMetric("MonitorAgent", {{"host", monitor_->HostName()}},
+                        {{"clients", long(clients_.size())},
+                         {"connects", stat_clients_},
+                         {"frames", stat_frames_},
+                         {"bytes", stat_bytes_},
+                         {"points", stat_points_},
+                         {"forwarded", stat_forwarded_},
+                         {"errors", stat_errors_}});
+  stat_clients_ = 0;
+  stat_frames_ = 0;
+  stat_bytes_ = 0;
+  stat_points_ = 0;
+  stat_forwarded_ = 0;
+  stat_errors_ = 0;
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#ifndef INCLUDE_APPLICATION
+#define INCLUDE_APPLICATION
+
+#include "FileDescriptor.hpp"
+#include "Metric.hpp"
+#include "Monitor.hpp"
+#include "Parameters.hpp"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Application {
+public:
+  explicit Application(Parameters const& par);
+  ~Application();
+  void run();
+
+  Application(const Application&) = delete;
+  void operator=(const Application&) = delete;
+
+private:
+  /// A connected agent: sink, with its partially received frame.
+  struct Client {
+    std::string buf;
+  };
+
+  void accept_clients();
+  bool read_client(int fd, Client& client);
+  void forward(std::vector<cbm::Metric>& metvec);
+  void flush_aggregate();
+  void queue_stats();
+
+  /// The run parameters object.
+  Parameters const& par_;
+
+  cbm::FileDescriptor signal_fd_;
+  std::unique_ptr<cbm::Monitor> monitor_;
+  cbm::FileDescriptor listen_fd_;
+  std::map<int, Client> clients_;
+
+  /// Aggregated series: index by series key, last value of each field.
+  std::unordered_map<std::string, size_t> agg_index_;
+  std::vector<cbm::Metric> agg_;
+
+  /// Self-monitoring counters, reset when queued.
+  long stat_clients_ = 0;
+  long stat_frames_ = 0;
+  long stat_bytes_ = 0;
+  long stat_points_ = 0;
+  long stat_forwarded_ = 0;
+  long stat_errors_ = 0;
+};
+
+#endif
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Parameters.hpp"
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+Parameters::Parameters(int argc, char* argv[]) {
+  po::options_description generic("Generic options");
+  auto generic_add = generic.add_options();
+  generic_add("help,h", "display this help and exit");
+  generic_add("socket,s",
+              po::value<std::string>(&socket)
+                  ->value_name("<path>")
+                  ->default_value(socket),
+              "listen on Unix socket <path>, used in the agent:<path> sink");
+  generic_add("monitor,m",
+              po::value<std::vector<std::string>>(&monitor_uris)
+                  ->value_name("<uri>")
+                  ->composing(),
+              "forward to sink <uri>, can be repeated; e.g. "
+              "influx1:host:8086:db?keepalive&gzip&parallel=4");
+  generic_add("aggregate,a",
+              po::value<double>(&aggregate)->value_name("<s>")->default_value(
+                  aggregate),
+              "keep only the last value of each series and field per <s> "
+              "seconds, 0 forwards all points");
+  generic_add("stats",
+              po::value<double>(&stats)->value_name("<s>")->default_value(
+                  stats),
+              "interval of the agent self-monitoring metric, 0 disables it");
+
+  po::options_description cmdline_options("Allowed options");
+  cmdline_options.add(generic);
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, cmdline_options), vm);
+  po::notify(vm);
+
+  if (vm.count("help") != 0u) {
+    std::cout << "node-local monitor agent"
+              << "\n";
+    std::cout << cmdline_options << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+  if (monitor_uris.empty())
+    monitor_uris.push_back("file:cout");
+  if (aggregate < 0. || stats < 0.)
+    throw ParametersException("aggregate and stats must not be negative");
+}
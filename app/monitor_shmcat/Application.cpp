@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Application.hpp"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+Application::Application(Parameters const& par) : par_(par) {
+  ring_ = std::make_unique<cbm::MonitorShmRing>(par.name);
+  if (!par.output.empty()) {
+    ofile_ = std::make_unique<std::ofstream>(par.output, std::ios::app);
+    if (!ofile_->is_open())
+      throw ParametersException("can't open output file " + par.output);
+  }
+}
+
+void Application::run() {
+  std::ostream& os = ofile_ ? *ofile_ : std::cout;
+  std::string record;
+  while (true) {
+    bool alive = ring_->WriterAlive(); // check before drain, avoids a race
+    while (ring_->Read(record))
+      os.write(record.data(), std::streamsize(record.size()));
+    os.flush();
+    if (!par_.follow || !alive)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(par_.interval));
+  }
+
+  if (par_.unlink && !ring_->WriterAlive())
+    ring_->Unlink();
+
+  if (par_.stats) {
+    auto stats = ring_->Statistics();
+    std::cerr << "ring " << ring_->Name() << ": writer pid "
+              << stats.fWriterPid << ", capacity " << stats.fCapacity
+              << ", records " << stats.fNWrite << ", bytes "
+              << stats.fNWriteByte << ", overwrites " << stats.fNOverwrite
+              << " (" << stats.fNOverwriteByte << " bytes), drops "
+              << stats.fNDrop << ", fill " << stats.fFill << "\n";
+  }
+}
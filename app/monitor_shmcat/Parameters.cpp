@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2022 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "Parameters.hpp"
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+Parameters::Parameters(int argc, char* argv[]) {
+  po::options_description generic("Generic options");
+  auto generic_add = generic.add_options();
+  generic_add("help,h", "display this help and exit");
+  generic_add("name,n", po::value<std::string>(&name)->value_name("<name>"),
+              "ring name, as given in the shm:<name> sink");
+  generic_add("output,o", po::value<std::string>(&output)->value_name("<file>"),
+              "append lines to <file> instead of stdout");
+  generic_add("follow,f", po::bool_switch(&follow),
+              "keep reading until the writer process ended");
+  generic_add("interval,i", po::value<int>(&interval)->default_value(interval),
+              "poll interval when the ring is empty (in ms)");
+  generic_add("unlink,u", po::bool_switch(&unlink),
+              "remove the ring when drained and the writer ended");
+  generic_add("stats,s", po::bool_switch(&stats),
+              "print ring statistics to stderr at exit");
+
+  po::positional_options_description positional;
+  positional.add("name", 1);
+
+  po::options_description cmdline_options("Allowed options");
+  cmdline_options.add(generic);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+                .options(cmdline_options)
+                .positional(positional)
+                .run(),
+            vm);
+  po::notify(vm);
+
+  if (vm.count("help") != 0u) {
+    std::cout << "monitor shared memory ring reader"
+              << "\n";
+    std::cout << cmdline_options << std::endl;
+    exit(EXIT_SUCCESS);
+  }
+  if (name.empty())
+    throw ParametersException("no ring name given");
+}
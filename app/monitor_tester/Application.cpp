@@ -10,24 +10,66 @@
 
 Application::Application(Parameters const& par) : par_(par) {
 
+  // start up mock InfluxDB server ------------------------
+  if (par.mock)
+    mock_ = std::make_unique<cbm::MonitorInfluxMock>();
+
   // start up Monitor --------------------------------------
   monitor_ = std::make_unique<cbm::Monitor>();
   if (!par.monitor_uri.empty()) {
     monitor_->OpenSink(par.monitor_uri);
+  } else if (mock_) {
+    monitor_->OpenSink("influx1:127.0.0.1:" + std::to_string(mock_->Port()) +
+                       ":");
   } else {
     monitor_->OpenSink("file:cout");
   }
 }
 
 void Application::run() {
+  if (par_.points > 0) {
+    benchmark();
+    return;
+  }
   // do something
   cbm::Monitor::Ref().QueueMetric(
       "demo_measurement", {{"hostname", "N/A"}},
       {{"an_int", 17}, {"a_float", 1.7}, {"a_bool", true}});
 }
 
+void Application::benchmark() {
+  // queue points round robin over series, then measure time until the
+  // Monitor has delivered everything, which is when its destructor returns
+  auto tbeg = std::chrono::steady_clock::now();
+  for (long i = 0; i < par_.points; i++) {
+    monitor_->QueueMetric(
+        "bench_measurement",
+        {{"hostname", "N/A"}, {"series", std::to_string(i % par_.series)}},
+        {{"index", i}, {"value", 0.5 * double(i)}});
+  }
+  auto tqueue = std::chrono::steady_clock::now();
+  monitor_.reset();
+  auto tend = std::chrono::steady_clock::now();
+
+  std::chrono::duration<double> dqueue = tqueue - tbeg;
+  std::chrono::duration<double> dtotal = tend - tbeg;
+  std::cout << "queued    " << par_.points << " points in " << dqueue.count()
+            << " s\n";
+  std::cout << "delivered " << par_.points << " points in " << dtotal.count()
+            << " s, " << double(par_.points) / dtotal.count()
+            << " points/s\n";
+  if (mock_) {
+    auto stats = mock_->Statistics();
+    std::cout << "mock: requests " << stats.fNRequest << " lines "
+              << stats.fNLine << " bytes " << stats.fNByte << " bad "
+              << stats.fNBadLine << " connections " << stats.fNConn << "\n";
+  }
+}
+
 Application::~Application() {
   // delay to allow monitor to process pending messages
   constexpr auto destruct_delay = std::chrono::milliseconds(200);
-  std::this_thread::sleep_for(destruct_delay);
+  if (monitor_)
+    std::this_thread::sleep_for(destruct_delay);
+  monitor_.reset(); // stop Monitor before the mock server it may send to
 }
@@ -6,6 +6,7 @@
 #define INCLUDE_APPLICATION
 
 #include "Monitor.hpp"
+#include "MonitorInfluxMock.hpp"
 #include "Parameters.hpp"
 #include <memory>
 
@@ -14,6 +15,7 @@ public:
   explicit Application(Parameters const& par);
   ~Application();
   void run();
+  void benchmark();
 
   Application(const Application&) = delete;
   void operator=(const Application&) = delete;
@@ -22,6 +24,7 @@ private:
   /// The run parameters object.
   Parameters const& par_;
 
+  std::unique_ptr<cbm::MonitorInfluxMock> mock_;
   std::unique_ptr<cbm::Monitor> monitor_;
 };
 
@@ -17,6 +17,14 @@ Parameters::Parameters(int argc, char* argv[]) {
                   ->value_name("<uri>")
                   ->implicit_value("influx1:login:8086:"),
               "publish status to InfluxDB");
+  generic_add("mock", po::bool_switch(&mock),
+              "run an embedded mock InfluxDB server, used as default sink");
+  generic_add("points,n", po::value<long>(&points)->value_name("<n>"),
+              "benchmark: queue <n> points and report throughput");
+  generic_add("series,s",
+              po::value<long>(&series)->value_name("<n>")->default_value(
+                  series),
+              "benchmark: number of distinct series");
 
   po::options_description cmdline_options("Allowed options");
   cmdline_options.add(generic);
@@ -31,4 +39,6 @@ Parameters::Parameters(int argc, char* argv[]) {
     std::cout << cmdline_options << std::endl;
     exit(EXIT_SUCCESS);
   }
+  if (series < 1)
+    throw ParametersException("series must be at least 1");
 }
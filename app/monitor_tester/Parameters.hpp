@@ -35,6 +35,9 @@ public:
   void operator=(const Parameters&) = delete;
 
   std::string monitor_uri;
+  bool mock = false;
+  long points = 0;
+  long series = 100;
 };
 
 #endif
@@ -3,13 +3,19 @@
 // Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
 
 #include "Application.hpp"
+#include "CrashHandler.hpp"
 #include "PThreadHelper.hpp"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 Application::Application(Parameters const& par) : par_(par) {
 
+  if (!par.crashlog.empty())
+    cbm::CrashHandler::Install(par.crashlog);
+
   // start up Logger ---------------------------------------
   logger_ = std::make_unique<cbm::Logger>();
   // set main thread name, for convenience (e.g. for top 'H' display)
@@ -37,6 +43,10 @@ Application::Application(Parameters const& par) : par_(par) {
 }
 
 void Application::run() {
+  if (par_.messages > 0) {
+    benchmark();
+    return;
+  }
   // do something
   CBMLOGERR1("cid=__Application", "CBM-1") << "Example error message 1";
   cbm::Monitor::Ref().QueueMetric(
@@ -44,8 +54,47 @@ void Application::run() {
       {{"an_int", 17}, {"a_float", 1.7}, {"a_bool", true}});
 }
 
+void Application::benchmark() {
+  // log from several threads concurrently, then measure time until the
+  // Logger has written everything, which is when its destructor returns
+  long nthread = std::max(par_.threads, 1L);
+  long nper = par_.messages / nthread;
+  std::vector<std::thread> workers;
+  auto tbeg = std::chrono::steady_clock::now();
+  for (long t = 0; t < nthread; t++) {
+    workers.emplace_back([t, nper, binary = par_.binary]() {
+      cbm::SetPThreadName("Cbm:bench" + std::to_string(t));
+      for (long i = 0; i < nper; i++) {
+        if (binary)
+          CBMLOGBIN(true, cbm::Logger::kLogInfo, "cid=__Application", "bench",
+                    "benchmark message {} value {}", i, 0.5 * double(i));
+        else
+          CBMLOG(true, cbm::Logger::kLogInfo, "cid=__Application", "bench",
+                 "")
+              << "benchmark message " << i << " value " << 0.5 * double(i);
+      }
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+  auto tqueue = std::chrono::steady_clock::now();
+  logger_.reset();
+  auto tend = std::chrono::steady_clock::now();
+
+  long ntotal = nper * nthread;
+  std::chrono::duration<double> dqueue = tqueue - tbeg;
+  std::chrono::duration<double> dtotal = tend - tbeg;
+  std::cout << "queued    " << ntotal << " messages from " << nthread
+            << " threads in " << dqueue.count() << " s, "
+            << double(ntotal) / dqueue.count() << " messages/s, "
+            << 1.e9 * dqueue.count() / double(nper) << " ns/message\n";
+  std::cout << "written   " << ntotal << " messages in " << dtotal.count()
+            << " s, " << double(ntotal) / dtotal.count() << " messages/s\n";
+}
+
 Application::~Application() {
   // delay to allow logger and monitor to process pending messages
   constexpr auto destruct_delay = std::chrono::milliseconds(200);
-  std::this_thread::sleep_for(destruct_delay);
+  if (logger_)
+    std::this_thread::sleep_for(destruct_delay);
 }
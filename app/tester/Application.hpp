@@ -15,6 +15,7 @@ public:
   explicit Application(Parameters const& par);
   ~Application();
   void run();
+  void benchmark();
 
   Application(const Application&) = delete;
   void operator=(const Application&) = delete;
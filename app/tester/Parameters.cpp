@@ -22,6 +22,17 @@ Parameters::Parameters(int argc, char* argv[]) {
                   ->value_name("<uri>")
                   ->implicit_value("influx1:login:8086:"),
               "publish status to InfluxDB");
+  generic_add("messages,n", po::value<long>(&messages)->value_name("<n>"),
+              "benchmark: log <n> Info messages and report throughput");
+  generic_add("threads,t",
+              po::value<long>(&threads)->value_name("<n>")->default_value(
+                  threads),
+              "benchmark: number of logging threads");
+  generic_add("binary", po::bool_switch(&binary),
+              "benchmark: log with deferred formatting via CBMLOGBIN");
+  generic_add("crashlog",
+              po::value<std::string>(&crashlog)->value_name("<filename>"),
+              "on a fatal signal write queued messages and metrics to file");
 
   /*
            << "  Default for all LogLevels is Info\n"
@@ -37,6 +37,10 @@ public:
   std::string logfile;
   bool nosyslog = false;
   std::string monitor_uri;
+  long messages = 0;
+  long threads = 1;
+  bool binary = false;
+  std::string crashlog;
 };
 
 #endif
@@ -4,7 +4,9 @@
 
 #include "Logger.hpp"
 
+#include "CrashHandler.hpp"
 #include "Exception.hpp"
+#include "LoggerSinkDevlog.hpp"
 #include "LoggerSinkFile.hpp"
 #include "LoggerSinkMonitor.hpp"
 #include "LoggerSinkSyslog.hpp"
@@ -13,10 +15,14 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+
 #include <errno.h>
 #include <poll.h>
+#include <pthread.h>
 #include <sys/eventfd.h>
 #include <sys/timerfd.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace cbm {
@@ -105,14 +111,26 @@ namespace cbm {
   For cases where one sequence of `operator<<()`s is not sufficient the
   low level interface provided by MakeStream() can be used directly.
 
+  For messages in hot code paths, e.g. trace level instrumentation in
+  loops, the macro `CBMLOGBIN(sel,sev,keys1,mid,fmt,args...)` defers all
+  formatting to the Logger work thread
+  \code{.cpp}
+  CBMLOGBIN(lvl <= Logger::kLogTrace, Logger::kLogTrace, "cid=Reader",
+            "ReadBlock", "block {} at {:#x}, size {}", ib, addr, size);
+  \endcode
+  The call site context is kept in a `static` object, only the timestamp
+  and the raw arguments are copied into a per-thread LoggerBinBuffer. The
+  work thread formats them with `fmt` when it processes the messages.
+
   The Logger back-end is provided by LoggerSink objects and controlled via
   - OpenSink(): creates a new sink
   - CloseSink(): removes a sink
   - SinkLogLevel(): changes the \glos{loglevel} of a sink
 
-  Currently three sink types are implemented
+  Currently four sink types are implemented
   - LoggerSinkFile: writes to files
   - LoggerSinkSyslog: writes to `syslog(3)`
+  - LoggerSinkDevlog: writes directly to the syslog socket `/dev/log`
   - LoggerSinkMonitor: write to Monitor
 
   The Logger is a \glos{singleton} and accessed via the Logger::Ref() static
@@ -129,16 +147,44 @@ namespace cbm {
   \note On \ref objectownership
     - is owned by Context
 
+  \note On the compile-time severity floor
+    - messages with a severity below the CMake cache variable
+      `CBMLOG_MIN_LEVEL` (default `Trace`) are removed at compile time.
+      For macros with a constant severity, like CBMLOGTRA() or CBMLOGDEB(),
+      the selection becomes `if (false && ...)`, so neither the selector
+      nor the `operator<<()`s are evaluated and the compiler drops the code.
+    - the \glos{loglevel} checks stay in place for all levels at or above
+      the floor.
+
   \note **Implementation notes**
   - the macros first evaluate the selection, and create message context and
     body only when the message is actually written. The `operator<<()` are
     only executed for messages passed on to the Logger core.
-  - the Logger uses a worker thread named "Cbm:logger" and a `mutex` to
-    protect the message queue. The code sequences executed under `mutex` lock
-    use `std::move` and are absolutely minimal, contention when locking the
-    `mutex` is thus very unlikely:
-    - at message creation: just a `vector::push_back(move(...))`
-    - at message processing: just a `vector::swap(...)`
+  - the macros also check the severity against MinSinkLogLevel(), the
+    lowest \glos{loglevel} of all open sinks and of the flight recorder,
+    which is kept in an `atomic`.
+    A message which no sink would write, or any message while no sink is
+    open or no Logger exists, is thus dropped before it is created at the
+    cost of two loads.
+  - with SetRateLimit() the rate of identical messages can be limited,
+    storms of one message are then reduced to a configurable rate plus
+    a periodic summary of the number of suppressed messages.
+  - the Logger uses a worker thread named "Cbm:logger" and a lock-free
+    MpscQueue as message queue. Producing threads never block each other
+    or the worker, a message is queued with one atomic exchange. The
+    queue nodes are recycled, so queueing doesn't allocate.
+  - the worker is woken via an `eventfd` only for `Note` and higher
+    messages, and only by the first of them after the worker last looked
+    at the queue. A burst of `Note` messages thus costs one `write(2)`.
+  - with OpenRecorder() a flight recorder keeps the most recent messages
+    of all severities in a memory mapped file, which survives a crash.
+  - when a CrashHandler is installed the still queued messages are written
+    on a fatal signal, see CrashHook().
+  - CBMLOGBIN() messages do not wake the worker unless a LoggerBinBuffer is
+    more than half full. They are passed to the sinks after the queued
+    messages of the same processing cycle and thus not necessarily in time
+    order with them. When a buffer is full messages are dropped, the
+    number of dropped messages is reported with a `Warning`.
 */
 
 //-----------------------------------------------------------------------------
@@ -152,7 +198,8 @@ namespace cbm {
 
 Logger::Logger()
     : fSevCode2Text{"Trace",   "Debug", "Info", "Note",
-                    "Warning", "Error", "Fatal"} {
+                    "Warning", "Error", "Fatal"},
+      fMinSinkLogLevel(kLogFatal + 1), fMinQueueLogLevel(kLogFatal + 1) {
   // singleton check
   if (fpSingleton)
     throw Exception("Logger::ctor: already instantiated");
@@ -172,8 +219,12 @@ Logger::Logger()
   // get progname
   fProgName = PThreadName();
 
+  static atomic<uint64_t> instcnt{0};
+  fInstance = ++instcnt;
+
   // start EventLoop
   fThread = thread([this]() { EventLoop(); });
+  CrashHandler::AddHook(&Logger::CrashHook, this);
 
   fpSingleton = this;
 }
@@ -186,6 +237,7 @@ Logger::Logger()
  */
 
 Logger::~Logger() {
+  CrashHandler::RemoveHook(this);
   fpSingleton = nullptr;
   Stop();
 }
@@ -252,6 +304,7 @@ int Logger::SeverityText2Code(const string& sevtext, bool nothrow) {
   `sname` must have the form `proto:path`. Currently supported `proto` values
   - `file`: will create a LoggerSinkFile sink
   - `syslog`: will create a LoggerSinkSyslog sink
+  - `devlog`: will create a LoggerSinkDevlog sink
   - `monitor`: will create a LoggerSinkMonitor sink
  */
 
@@ -279,16 +332,25 @@ void Logger::OpenSink(const string& sname, int lvl) {
         make_unique<LoggerSinkFile>(*this, spath, lvl);
     lock_guard<mutex> lock(fSinkMapMutex);
     fSinkMap.try_emplace(sname, move(uptr));
+    UpdateMinSinkLogLevel();
   } else if (stype == "syslog") {
     unique_ptr<LoggerSink> uptr =
         make_unique<LoggerSinkSyslog>(*this, spath, lvl);
     lock_guard<mutex> lock(fSinkMapMutex);
     fSinkMap.try_emplace(sname, move(uptr));
+    UpdateMinSinkLogLevel();
+  } else if (stype == "devlog") {
+    unique_ptr<LoggerSink> uptr =
+        make_unique<LoggerSinkDevlog>(*this, spath, lvl);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+    UpdateMinSinkLogLevel();
   } else if (stype == "monitor") {
     unique_ptr<LoggerSink> uptr =
         make_unique<LoggerSinkMonitor>(*this, spath, lvl);
     lock_guard<mutex> lock(fSinkMapMutex);
     fSinkMap.try_emplace(sname, move(uptr));
+    UpdateMinSinkLogLevel();
   } else {
     throw Exception(
         fmt::format("Logger::OpenSink: invalid sink type '{}'", stype));
@@ -306,6 +368,7 @@ void Logger::CloseSink(const string& sname) {
   if (fSinkMap.erase(sname) == 0)
     throw Exception(
         fmt::format("Logger::CloseSink: sink '{}' not found", sname));
+  UpdateMinSinkLogLevel();
 }
 
 //-----------------------------------------------------------------------------
@@ -340,6 +403,75 @@ int Logger::SinkLogLevel(const string& sname) {
 void Logger::SetSinkLogLevel(const string& sname, int lvl) {
   lock_guard<mutex> lock(fSinkMapMutex);
   SinkRef(sname).SetLogLevel(lvl);
+  UpdateMinSinkLogLevel();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Open the flight recorder
+  \param spec       file name and options, see below
+  \param lvl        \glos{loglevel} for recording
+  \param dumpsink   name of the sink for a dump on `Fatal`, default none
+  \throws Exception if the recorder is already open or `spec` is invalid
+  \throws SysCallException if the file can't be created
+
+  The flight recorder keeps the most recent messages with a severity of
+  `lvl` or above in a ring in a memory mapped file, see LoggerRecorder.
+  It is independent of the sink \glos{loglevel}s, so it also holds the
+  messages no sink writes, and it survives a crash of the process. The
+  file can be decoded with the `logger_recdump` tool. The file of a
+  previous run is kept with the suffix `.prev`.
+
+  The file name can be followed by `?` and these options
+  - `size`: size of the ring in bytes (default '4M')
+  - `slot`: size of one message slot in bytes, longer messages are
+    truncated (default 256)
+
+  Messages are recorded by the thread which creates them, the message
+  text is copied into the ring in the LoggerStream destructor. CBMLOGBIN()
+  messages are recorded by the work thread when formatted.
+
+  When `dumpsink` is given the recorder content is written to the sink
+  named `dumpsink` after a `Fatal` message, with all severities.
+
+  The recorder can be opened only once and stays open until the Logger is
+  destroyed.
+ */
+
+void Logger::OpenRecorder(const string& spec,
+                          int lvl,
+                          const string& dumpsink) {
+  SinkOptions opts(spec);
+  opts.Check("Logger::OpenRecorder", {"size", "slot"});
+  lock_guard<mutex> lock(fSinkMapMutex);
+  if (fRecorder)
+    throw Exception("Logger::OpenRecorder: recorder already open");
+  fRecorder = make_unique<LoggerRecorder>(
+      opts.Path(), opts.Size("size", kRecSize),
+      opts.Size("slot", kRecSlotSize), fProgName, fHostName);
+  fRecLogLevel = lvl;
+  fRecDumpSink = dumpsink;
+  fpRecorder.store(fRecorder.get(), memory_order_release);
+  UpdateMinSinkLogLevel();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Configure rate limiting of messages
+  \param rate     sustained rate of messages per second, `0` disables
+  \param burst    number of messages admitted in a burst
+  \param period   interval of summary reports in s, default 10 s
+
+  Limits the rate of messages with identical severity, environment keys,
+  and \glos{messageid}, see LoggerRateLimiter. The check is done in the
+  LoggerStream constructor, a suppressed message is neither formatted nor
+  queued. Every `period` seconds one message with the keys and severity
+  of the suppressed messages reports how many were suppressed.
+  Rate limiting is disabled by default. `Fatal` messages and CBMLOGBIN()
+  messages are never rate limited.
+ */
+
+void Logger::SetRateLimit(double rate, double burst, double period) {
+  fRatePeriod.store(max(period, 0.1));
+  fRateLimiter.Configure(rate, burst);
 }
 
 //-----------------------------------------------------------------------------
@@ -349,12 +481,9 @@ void Logger::SetSinkLogLevel(const string& sname, int lvl) {
 
 void Logger::QueueMessage(LoggerMessage&& msg) {
   bool wakeup = msg.fSevId >= kLogNote;
-  {
-    lock_guard<mutex> lock(fMsgVecMutex);
-    fMsgVec.push_back(move(msg));
-  }
+  fMsgQueue.Push(move(msg));
   if (wakeup)
-    Wakeup();
+    RequestWakeup();
 }
 
 //-----------------------------------------------------------------------------
@@ -387,6 +516,19 @@ void Logger::Wakeup() {
     throw SysCallException("Logger::Wakeup"s, "write"s, "fEvtFd"s, errno);
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief Wakeup work thread unless a wakeup is already pending
+
+  Only the idle -> pending transition writes the `eventfd`, the flag is
+  cleared by the work thread before it drains the queues.
+ */
+
+void Logger::RequestWakeup() {
+  if (!fWakeupPending.load(memory_order_relaxed) &&
+      !fWakeupPending.exchange(true))
+    Wakeup();
+}
+
 //-----------------------------------------------------------------------------
 /*! \brief The event loop of Logger work thread
  */
@@ -397,6 +539,8 @@ void Logger::EventLoop() {
 
   pollfd polllist[1];
   polllist[0] = pollfd{fEvtFd, POLLIN, 0};
+  msgvec_t msgvec;
+  auto tratelast = chrono::steady_clock::now();
 
   while (true) {
     ::poll(polllist, 1, kELoopTimeout); // timeout results in auto flush
@@ -408,35 +552,193 @@ void Logger::EventLoop() {
         throw SysCallException("Logger::EventLoop"s, "read"s, "fEvtFd"s, errno);
     }
 
-    msgvec_t msgvec;
-    {
-      lock_guard<mutex> lock(fMsgVecMutex);
-      if (!fMsgVec.empty()) {
-        // move whole vector from protected queue to local environment
-        msgvec.swap(fMsgVec);
-        // determine sensible capacity to minimize re-allocs
-        size_t ncap = msgvec.capacity();
-        if (msgvec.size() > msgvec.capacity() / 2)
-          ncap += ncap / 2;
-        else
-          ncap = ncap / 2;
-        if (ncap < 4)
-          ncap = 4;
-        fMsgVec.reserve(ncap);
-      }
+    // the last round must start after Stop(), so that it takes all messages
+    bool stopped = fStopped;
+
+    // re-arm wakeup before draining, a message queued after this point
+    // either is drained below or will write the eventfd again
+    fWakeupPending.store(false);
+    fQueueBusy.store(true);
+    while (fCrashPark.load()) { // CrashHook() reads the queue, wait for it
+      fQueueBusy.store(false);
+      this_thread::sleep_for(chrono::milliseconds(10));
+      fQueueBusy.store(true);
+    }
+    fMsgQueue.PopAll(msgvec); // bounded, newer messages wait for next round
+    fQueueBusy.store(false);
+    DrainBinBuffers(msgvec);
+
+    // report messages suppressed by the rate limiter
+    auto tnow = chrono::steady_clock::now();
+    double period = fRatePeriod.load();
+    if (stopped || tnow - tratelast >= chrono::duration<double>(period)) {
+      fRateLimiter.Report(msgvec, period);
+      tratelast = tnow;
     }
 
-    if (msgvec.size() > 0) {
+    {
       lock_guard<mutex> lock(fSinkMapMutex);
+      if (msgvec.size() > 0) {
+        for (auto& kv : fSinkMap)
+          (*kv.second).ProcessMessageVec(msgvec);
+        if (fRecorder && !fRecDumpSink.empty() &&
+            any_of(msgvec.begin(), msgvec.end(), [](auto& msg) {
+              return msg.fSevId >= kLogFatal;
+            }))
+          DumpRecorder();
+      }
       for (auto& kv : fSinkMap)
-        (*kv.second).ProcessMessageVec(msgvec);
+        (*kv.second).ProcessHeartbeat();
     }
+    msgvec.clear(); // keeps capacity, avoids re-allocs
 
-    if (fStopped)
+    if (stopped)
       break;
   } // while (true)
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief CrashHandler hook, writes the queued messages
+  \param ctx   the Logger
+  \param buf   output buffer
+
+  Runs in a signal handler. The work thread is first parked, it stops
+  before it drains the queue next time, unless the crash happened in the
+  work thread itself. When the work thread doesn't reach that point within
+  100 ms the queue is not written. The queued messages are then formatted
+  like by LoggerSinkFile, but with a UTC time stamp. A crash of the work
+  thread inside MpscQueue::Pop() is safe, see MpscQueue::ForEach().
+
+  The work thread is released when the hook returns. Normally the process
+  is terminated by the re-raised signal right after. If it is not, e.g.
+  because the previous signal action is a handler which returns, the work
+  thread simply continues and also passes the written messages to the sinks.
+
+  Messages taken by the work thread before the crash and CBMLOGBIN()
+  messages still in the LoggerBinBuffer are not written.
+ */
+
+void Logger::CrashHook(void* ctx, CrashBuffer& buf) {
+  Logger& self = *static_cast<Logger*>(ctx);
+  if (!pthread_equal(::pthread_self(), self.fThread.native_handle())) {
+    self.fCrashPark.store(true);
+    for (int i = 0; i < 100 && self.fQueueBusy.load(); i++) {
+      timespec ts{0, 1000000};
+      (void)::nanosleep(&ts, nullptr);
+    }
+    if (self.fQueueBusy.load()) {
+      buf.Append("Logger: work thread busy, queue not written\n");
+      self.fCrashPark.store(false);
+      return;
+    }
+  }
+
+  size_t nmsg = self.fMsgQueue.ForEach([&self, &buf](const LoggerMessage& msg) {
+    buf.AppendTime(msg.fTime);
+    buf.Append(": {host=");
+    buf.Append(self.fHostName);
+    buf.Append(",thread=");
+    buf.Append(msg.fThreadName);
+    buf.Append(",sev=");
+    if (msg.fSevId >= 0 && msg.fSevId <= kLogFatal) {
+      buf.Append(self.fSevCode2Text[size_t(msg.fSevId)]);
+    } else {
+      buf.AppendInt(msg.fSevId);
+    }
+    if (msg.fKeysSize) {
+      buf.Append(',');
+      buf.Append(msg.Keys());
+    }
+    buf.Append("}: ");
+    buf.Append(msg.Message());
+    buf.Append('\n');
+  });
+  buf.Append("Logger: ");
+  buf.AppendUInt(nmsg);
+  buf.Append(" queued messages written\n");
+  self.fCrashPark.store(false);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the LoggerBinBuffer of the calling thread
+
+  The buffer is created and registered at the first call in a thread. It
+  is marked as retired when the thread ends, and removed by the work thread
+  once it is drained.
+ */
+
+LoggerBinBuffer& Logger::BinBuffer() {
+  struct Holder {
+    ~Holder() {
+      if (fBuffer)
+        fBuffer->Retire();
+    }
+    binbuf_sptr_t fBuffer{}; //!< buffer of this thread
+    uint64_t fInstance{0};   //!< Logger instance it is registered with
+  };
+  static thread_local Holder holder;
+
+  if (holder.fInstance != fInstance) {
+    if (holder.fBuffer)
+      holder.fBuffer->Retire();
+    holder.fBuffer = make_shared<LoggerBinBuffer>(size_t(kBinBufSize),
+                                                  PThreadName());
+    holder.fInstance = fInstance;
+    lock_guard<mutex> lock(fBinBufsMutex);
+    fBinBufs.push_back(holder.fBuffer);
+  }
+  return *holder.fBuffer;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Formats all records of the binary buffers into messages
+  \param msgvec   message vector to which the messages are appended
+ */
+
+void Logger::DrainBinBuffers(vector<LoggerMessage>& msgvec) {
+  LoggerRecorder* precorder = Recorder();
+  lock_guard<mutex> lock(fBinBufsMutex);
+  for (auto it = fBinBufs.begin(); it != fBinBufs.end();) {
+    LoggerBinBuffer& buf = **it;
+    bool retired = buf.Retired(); // when set all records are visible
+    size_t nbyte = 0;
+    while (const char* prec = buf.Front(nbyte)) {
+      LoggerBinCodec::Header hdr;
+      memcpy(&hdr, prec, sizeof(hdr));
+      const LoggerBinSite& site = *hdr.fSite;
+      string text(site.fKeys);
+      if (site.fMid[0] != 0) {
+        text += ",mid=";
+        text += site.fMid;
+      }
+      size_t nkeys = text.size();
+      try {
+        hdr.fFormat(hdr.fFmtStr, prec + sizeof(hdr), text);
+      } catch (const exception& e) {
+        text.resize(nkeys);
+        text += fmt::format("format '{}' failed: {}", hdr.fFmtStr, e.what());
+      }
+      if (precorder && site.fSevId >= RecorderLogLevel())
+        precorder->Record(hdr.fTime, site.fSevId, buf.ThreadName(), text,
+                          nkeys);
+      msgvec.emplace_back(hdr.fTime, site.fSevId, string(buf.ThreadName()),
+                          move(text), nkeys);
+      buf.Pop();
+    }
+    if (uint64_t ndrop = buf.TakeDropCount(); ndrop > 0) {
+      string keys = "cid=__Logger,mid=BinDrop";
+      size_t nkeys = keys.size();
+      msgvec.emplace_back(
+          ScNow(), kLogWarning, string(buf.ThreadName()),
+          keys + fmt::format("{} binary messages dropped", ndrop), nkeys);
+    }
+    if (retired && buf.Empty())
+      it = fBinBufs.erase(it);
+    else
+      ++it;
+  }
+}
+
 //-----------------------------------------------------------------------------
 /*! \brief Returns reference to a sink
   \param sname    sink name, given as proto:path
@@ -451,6 +753,68 @@ LoggerSink& Logger::SinkRef(const string& sname) {
   return *(it->second.get());
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief Recalculates the lowest \glos{loglevel} of all sinks
+
+  Must be called with `fSinkMapMutex` locked after any change of the
+  sink registry or of a sink \glos{loglevel}.
+ */
+
+void Logger::UpdateMinSinkLogLevel() {
+  int lvl = kLogFatal + 1;
+  for (auto& kv : fSinkMap)
+    lvl = min(lvl, kv.second->LogLevel());
+  fMinQueueLogLevel.store(lvl, memory_order_relaxed);
+  fMinSinkLogLevel.store(min(lvl, fRecLogLevel), memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Writes the flight recorder content to the dump sink
+
+  Called by the work thread with `fSinkMapMutex` locked after a `Fatal`
+  message was processed. The recorded messages are framed by two messages
+  with `cid=__Logger` and written regardless of the \glos{loglevel} of the
+  sink.
+
+  Only records newer than the previous dump are written, so a burst of
+  `Fatal` messages doesn't write the ring again and again. Records with a
+  severity at or above the \glos{loglevel} of the sink are skipped, the
+  sink writes them anyway as normal messages. Nothing is written when no
+  record is left.
+ */
+
+void Logger::DumpRecorder() {
+  auto it = fSinkMap.find(fRecDumpSink);
+  if (it == fSinkMap.end())
+    return;
+  LoggerSink& sink = *it->second;
+  int lvl = sink.LogLevel();
+
+  msgvec_t recvec;
+  fRecDumpNext = fRecorder->Snapshot(recvec, fRecDumpNext);
+  recvec.erase(remove_if(recvec.begin(), recvec.end(),
+                         [lvl](auto& msg) { return msg.fSevId >= lvl; }),
+               recvec.end());
+  if (recvec.empty())
+    return;
+
+  msgvec_t dumpvec;
+  string keys = "cid=__Logger,mid=RecDump";
+  size_t nkeys = keys.size();
+  dumpvec.emplace_back(ScNow(), kLogFatal, "Cbm:logger",
+                       keys + "begin of flight recorder dump", nkeys);
+  move(recvec.begin(), recvec.end(), back_inserter(dumpvec));
+  dumpvec.emplace_back(ScNow(), kLogFatal, "Cbm:logger",
+                       keys + fmt::format("end of flight recorder dump, {}"
+                                          " messages",
+                                          recvec.size()),
+                       nkeys);
+
+  sink.SetLogLevel(kLogTrace);
+  sink.ProcessMessageVec(dumpvec);
+  sink.SetLogLevel(lvl);
+}
+
 //-----------------------------------------------------------------------------
 // define static member variables
 
@@ -467,6 +831,8 @@ Logger* Logger::fpSingleton = nullptr;
   \param keys2 seconday environment keys
 
   This macro provides a _stream like_ interface to Logger. It
+  - drops the message if `sev` is below the compile-time floor
+    `CBMLOG_MIN_LEVEL` or below Logger::MinSinkLogLevel()
   - executes the selector `sel` in an `if(sel)` statement
   - if `true`, creates a message context with Logger::MakeMessage()
   - and expects that the message body is streamed in with an `operator<<()`
@@ -476,6 +842,29 @@ Logger* Logger::fpSingleton = nullptr;
   CBMLOGNOT1(keys1,mid), CBMLOGERR1(keys1,mid), and CBMLOGFAT1(keys1,mid)
   and usually not used directly.
 */
+/*!
+  \def CBMLOGBIN(sel,sev,keys1,mid,fmtstr,...)
+  \brief Writes a message with deferred formatting under selector `sel`
+  \param sel   selection expression, must return or convert to a `bool`
+  \param sev   severity
+  \param keys1 primary environment keys, must be a string literal
+  \param mid   \glos{messageid}, must be a string literal
+  \param fmtstr `fmt` format string, must be a string literal
+  \param ...   the arguments, at least one, use CBMLOG() for plain text
+
+  Unlike CBMLOG(sel,sev,keys1,mid,keys2) the message body is not created
+  on the calling thread. `sev`, `keys1`, and `mid` are stored once in a
+  `static` object at the call site, the arguments are copied in binary
+  form with Logger::QueueBinary() and formatted by the Logger work thread.
+  Only arithmetic and string arguments are supported. Strings are copied,
+  so they can be temporaries. The format string is checked against the
+  argument types at compile time with `FMT_STRING()`. The timestamp has
+  only kernel tick resolution, see ScNowCoarse().
+  Typical usage is
+  \code{.cpp}
+  CBMLOGBIN(true, Logger::kLogTrace, "cid=Reader", "Read", "n={} t={}", n, t);
+  \endcode
+*/
 /*!
   \def CBMLOGGEN(sev,mid,keys)
   \brief Writes a message if `sev` is `>=` the local `LogLevel()`
@@ -5,11 +5,20 @@
 #ifndef included_Cbm_Logger
 #define included_Cbm_Logger 1
 
+#include "CrashHandler.hpp"
 #include "FileDescriptor.hpp"
+#include "LoggerBinBuffer.hpp"
+#include "LoggerBinCodec.hpp"
 #include "LoggerMessage.hpp"
+#include "LoggerRateLimiter.hpp"
+#include "LoggerRecorder.hpp"
 #include "LoggerSink.hpp"
 #include "LoggerStream.hpp"
+#include "MpscQueue.hpp"
 
+#include "fmt/format.h"
+
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -49,16 +58,36 @@ public:
   vector<string> SinkList();
   int SinkLogLevel(const string& sname);
   void SetSinkLogLevel(const string& sname, int lvl);
+  int MinSinkLogLevel() const;
+  int MinQueueLogLevel() const;
+  void OpenRecorder(const string& spec,
+                    int lvl,
+                    const string& dumpsink = "");
+  LoggerRecorder* Recorder() const;
+  int RecorderLogLevel() const;
+  void SetRateLimit(double rate, double burst, double period = 10.);
+  bool RateAdmit(int sev,
+                 const string& keys1,
+                 const string& mid,
+                 const string& keys2);
 
   void QueueMessage(LoggerMessage&& msg);
+  template <typename... Args>
+  void QueueBinary(const LoggerBinSite& site,
+                   fmt::format_string<Args...> fmtstr,
+                   const Args&... args);
   const string& HostName() const;
   const string& ProgName() const;
 
   static Logger& Ref();
   static Logger* Ptr();
+  static bool Accepts(int sev);
 
   // some constants (!! when changed update definition of fSevCode2Text !!)
-  static const int kELoopTimeout = 100; //!< logger flush time in ms
+  static const int kELoopTimeout = 100;      //!< logger flush time in ms
+  static const size_t kBinBufSize = 1048576; //!< per-thread binary buffer
+  static const size_t kRecSize = 4194304;    //!< flight recorder size
+  static const size_t kRecSlotSize = 256;    //!< flight recorder slot size
   enum LoggerSeverityLevel {
     kLogTrace = 0, //!< Trace (very verbose)
     kLogDebug,     //!< Debug (verbose)
@@ -72,32 +101,58 @@ public:
 private:
   void Stop();
   void Wakeup();
+  void RequestWakeup();
   void EventLoop();
+  LoggerBinBuffer& BinBuffer();
+  void DrainBinBuffers(vector<LoggerMessage>& msgvec);
   LoggerSink& SinkRef(const string& sname);
+  void UpdateMinSinkLogLevel();
+  void DumpRecorder();
+  static void CrashHook(void* ctx, CrashBuffer& buf);
 
 private:
   using msgvec_t = vector<LoggerMessage>;
   using sink_uptr_t = unique_ptr<LoggerSink>;
   using smap_t = unordered_map<string, sink_uptr_t>;
-
-  FileDescriptor fEvtFd{};      //!< fd for eventfd file
-  thread fThread{};             //!< worker thread
-  msgvec_t fMsgVec{};           //!< message list
-  mutex fMsgVecMutex{};         //!< mutex for fMsgVec access
-  string fHostName{""};         //!< hostname
-  string fProgName{""};         //!< program name
-  bool fStopped{false};         //!< signals thread rundown
-  vector<string> fSevCode2Text; //!< code to text map (init in ctor)
-  smap_t fSinkMap{};            //!< sink registry
-  mutex fSinkMapMutex{};        //!< mutex for fSinkMap access
-  static Logger* fpSingleton;   //!< \glos{singleton} this
+  using binbuf_sptr_t = shared_ptr<LoggerBinBuffer>;
+
+  FileDescriptor fEvtFd{};                //!< fd for eventfd file
+  thread fThread{};                       //!< worker thread
+  MpscQueue<LoggerMessage> fMsgQueue{};   //!< message queue
+  atomic<bool> fWakeupPending{false};     //!< eventfd written, not yet seen
+  string fHostName{""};                   //!< hostname
+  string fProgName{""};                   //!< program name
+  atomic<bool> fStopped{false};           //!< signals thread rundown
+  atomic<bool> fQueueBusy{false};         //!< work thread drains fMsgQueue
+  atomic<bool> fCrashPark{false};         //!< CrashHook() stops work thread
+  vector<string> fSevCode2Text;           //!< code to text map (init in ctor)
+  smap_t fSinkMap{};                      //!< sink registry
+  mutex fSinkMapMutex{};                  //!< mutex for fSinkMap access
+  atomic<int> fMinSinkLogLevel;           //!< lowest \glos{loglevel} of all
+  atomic<int> fMinQueueLogLevel;          //!< lowest \glos{loglevel} of sinks
+  vector<binbuf_sptr_t> fBinBufs{};       //!< binary buffers of all threads
+  mutex fBinBufsMutex{};                  //!< mutex for fBinBufs access
+  uint64_t fInstance;                     //!< unique id of this instance
+  LoggerRateLimiter fRateLimiter{};       //!< message rate limiter
+  atomic<double> fRatePeriod{10.};        //!< rate limit report period in s
+  unique_ptr<LoggerRecorder> fRecorder{}; //!< flight recorder
+  atomic<LoggerRecorder*> fpRecorder{};   //!< published fRecorder
+  int fRecLogLevel{kLogFatal + 1};        //!< flight recorder \glos{loglevel}
+  string fRecDumpSink{""};                //!< sink for dump on Fatal
+  uint64_t fRecDumpNext{0};               //!< first record of next dump
+  static Logger* fpSingleton;             //!< \glos{singleton} this
 };
 
 } // end namespace cbm
 
+// compile-time severity floor, normally set via CMake, 0 keeps all levels
+#ifndef CBMLOG_MIN_LEVEL
+#define CBMLOG_MIN_LEVEL 0
+#endif
+
 // framework macros, usually not used directly
 #define CBMLOG(sel, sev, keys1, mid, keys2)                                    \
-  if (sel)                                                                     \
+  if ((sev) >= CBMLOG_MIN_LEVEL && ::cbm::Logger::Accepts(sev) && (sel))       \
   ::cbm::Logger::Ref().MakeStream(sev, keys1, mid, keys2).Stream()
 #define CBMLOGGEN(sev, mid, keys)                                              \
   CBMLOG(sev >= LogLevel(), sev, LogKeys(), mid, keys)
@@ -123,6 +178,14 @@ private:
   CBMLOG(true, ::cbm::Logger::kLogError, keys1, mid, "")
 #define CBMLOGNOT1(keys1, mid)                                                 \
   CBMLOG(true, ::cbm::Logger::kLogNote, keys1, mid, "")
+// for deferred formatting, `keys1`, `mid` and `fmtstr` must be string literals
+#define CBMLOGBIN(sel, sev, keys1, mid, fmtstr, ...)                           \
+  do {                                                                         \
+    static const ::cbm::LoggerBinSite cbmlogbin_site{sev, keys1, mid};         \
+    if ((sev) >= CBMLOG_MIN_LEVEL && ::cbm::Logger::Accepts(sev) && (sel))     \
+      ::cbm::Logger::Ref().QueueBinary(cbmlogbin_site, FMT_STRING(fmtstr),     \
+                                       __VA_ARGS__);                           \
+  } while (0)
 
 #include "Logger.ipp"
 
@@ -2,8 +2,93 @@
 // (C) Copyright 2020 GSI Helmholtzzentrum für Schwerionenforschung
 // Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
 
+#include "ChronoHelper.hpp"
+
+#include <cstring>
+
 namespace cbm {
 
+//-----------------------------------------------------------------------------
+/*! \brief Queues a message for deferred formatting
+  \param site     static context of the call site
+  \param fmtstr   `fmt` format string, must have static storage duration
+  \param args     arguments, only arithmetic and string types are supported
+
+  Only copies the arguments in binary form into the buffer of the calling
+  thread, see CBMLOGBIN(). The message is dropped when the buffer is full.
+  CBMLOGBIN() passes the format string with `FMT_STRING()`, so it is checked
+  against the argument types at compile time. The timestamp is taken with
+  ScNowCoarse(), it has the resolution of the kernel tick.
+ */
+
+template <typename... Args>
+inline void Logger::QueueBinary(const LoggerBinSite& site,
+                                fmt::format_string<Args...> fmtstr,
+                                const Args&... args) {
+  LoggerBinBuffer& buf = BinBuffer();
+  char* pbuf = buf.Reserve(LoggerBinCodec::Size(args...));
+  if (!pbuf)
+    return;
+  LoggerBinCodec::Header hdr{&LoggerBinCodec::Format<decay_t<Args>...>, &site,
+                             fmt::string_view(fmtstr).data(), ScNowCoarse()};
+  memcpy(pbuf, &hdr, sizeof(hdr));
+  LoggerBinCodec::Put(pbuf, args...);
+  if (buf.Commit()) // more than half full, don't wait for timeout
+    RequestWakeup();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the lowest \glos{loglevel} of all sinks
+
+  A message with a lower severity is not written by any sink nor recorded
+  by the flight recorder. Returns `kLogFatal+1` when no sink is open. Is
+  checked via Accepts() in CBMLOG() and CBMLOGBIN() before a message is
+  created.
+ */
+
+inline int Logger::MinSinkLogLevel() const {
+  return fMinSinkLogLevel.load(memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the lowest \glos{loglevel} of the sinks only
+
+  Like MinSinkLogLevel(), but without the flight recorder. A message with a
+  lower severity is only recorded and not queued.
+ */
+
+inline int Logger::MinQueueLogLevel() const {
+  return fMinQueueLogLevel.load(memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the flight recorder, `nullptr` if not opened
+
+inline LoggerRecorder* Logger::Recorder() const {
+  return fpRecorder.load(memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the flight recorder \glos{loglevel}, valid after Recorder()
+
+inline int Logger::RecorderLogLevel() const { return fRecLogLevel; }
+
+//-----------------------------------------------------------------------------
+/*! \brief Check a message against the rate limit
+  \param sev     message severity
+  \param keys1   primary environment keys
+  \param mid     message id
+  \param keys2   seconday environment keys
+  \returns `false` if the message is suppressed, see SetRateLimit()
+ */
+
+inline bool Logger::RateAdmit(int sev,
+                              const string& keys1,
+                              const string& mid,
+                              const string& keys2) {
+  return !fRateLimiter.Enabled() || fRateLimiter.Admit(sev, keys1, mid, keys2);
+}
+
 //-----------------------------------------------------------------------------
 //! \brief Returns hostname used by Logger
 
@@ -26,4 +111,17 @@ inline Logger& Logger::Ref() { return *fpSingleton; }
 
 inline Logger* Logger::Ptr() { return fpSingleton; }
 
+//-----------------------------------------------------------------------------
+/*! \brief Returns `true` if a message of severity `sev` would be written
+  \param sev   severity
+
+  Returns `false` when no Logger exists, so the macros can be used safely
+  before the Logger is created, after it is destroyed, or without one.
+ */
+
+inline bool Logger::Accepts(int sev) {
+  Logger* plog = fpSingleton;
+  return plog && sev >= plog->MinSinkLogLevel();
+}
+
 } // end namespace cbm
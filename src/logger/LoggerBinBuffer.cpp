@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "LoggerBinBuffer.hpp"
+
+namespace cbm {
+using namespace std;
+
+/*! \class LoggerBinBuffer
+  \brief Single producer single consumer ring buffer for binary log records
+
+  Holds the records written by Logger::QueueBinary() in one thread until
+  they are formatted by the Logger work thread. Each thread using
+  CBMLOGBIN() has its own buffer, so the producer side needs neither locks
+  nor atomic read-modify-write operations.
+
+  The write position `head` and read position `tail` are byte counters which
+  are only incremented. A record is a 32 bit length word, padded to 8 bytes,
+  followed by the body. A record is never split at the end of the data area,
+  the remaining space is filled by a pad record instead. When the buffer is
+  full new records are dropped and counted, the producer never waits.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param size    size of data area, rounded up to a power of 2
+  \param tname   name of the producer thread
+ */
+
+LoggerBinBuffer::LoggerBinBuffer(size_t size, const string& tname)
+    : fThreadName(tname) {
+  fSize = 4096;
+  while (fSize < size)
+    fSize *= 2;
+  fData = make_unique<char[]>(fSize);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the oldest record (consumer only)
+  \param nbyte   returns the size of the record body
+  \returns pointer to the record body, or `nullptr` if the buffer is empty
+
+  The record stays valid until Pop() is called.
+ */
+
+const char* LoggerBinBuffer::Front(size_t& nbyte) {
+  uint64_t tail = fTail.load(memory_order_relaxed);
+  uint64_t head = fHead.load(memory_order_acquire);
+  while (tail != head) {
+    uint64_t off = tail & (fSize - 1);
+    uint32_t len = 0;
+    memcpy(&len, fData.get() + off, sizeof(len));
+    if (len == 0xffffffffU) { // pad record, skip to begin of data area
+      tail += fSize - off;
+      fTail.store(tail, memory_order_release);
+      continue;
+    }
+    nbyte = len;
+    fFrontSize = RecordSize(len);
+    return fData.get() + off + 8;
+  }
+  return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Removes the record returned by Front() (consumer only)
+
+void LoggerBinBuffer::Pop() {
+  fTail.store(fTail.load(memory_order_relaxed) + fFrontSize,
+              memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` if no record is available (consumer only)
+
+bool LoggerBinBuffer::Empty() const {
+  return fTail.load(memory_order_relaxed) ==
+         fHead.load(memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the number of dropped records since the last call
+
+uint64_t LoggerBinBuffer::TakeDropCount() {
+  return fNDrop.exchange(0, memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Marks the buffer as abandoned by its producer thread
+
+void LoggerBinBuffer::Retire() { fRetired.store(true, memory_order_release); }
+
+} // end namespace cbm
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_LoggerBinBuffer
+#define included_Cbm_LoggerBinBuffer 1
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cbm {
+using namespace std;
+
+class LoggerBinBuffer {
+public:
+  LoggerBinBuffer(size_t size, const string& tname);
+
+  LoggerBinBuffer(const LoggerBinBuffer&) = delete;
+  LoggerBinBuffer& operator=(const LoggerBinBuffer&) = delete;
+
+  char* Reserve(size_t nbyte);
+  bool Commit();
+  const char* Front(size_t& nbyte);
+  void Pop();
+  bool Empty() const;
+
+  const string& ThreadName() const;
+  uint64_t TakeDropCount();
+  void Retire();
+  bool Retired() const;
+
+private:
+  static uint64_t RecordSize(size_t nbyte);
+
+private:
+  unique_ptr<char[]> fData;              //!< data area
+  size_t fSize;                          //!< size of data area, power of 2
+  string fThreadName;                    //!< name of producer thread
+  alignas(64) atomic<uint64_t> fHead{0}; //!< write position, producer
+  uint64_t fPendHead{0};                 //!< end of reserved record
+  uint64_t fTailCache{0};                //!< producer copy of fTail
+  atomic<uint64_t> fNDrop{0};            //!< # of dropped records
+  alignas(64) atomic<uint64_t> fTail{0}; //!< read position, consumer
+  uint64_t fFrontSize{0};                //!< record size of Front()
+  atomic<bool> fRetired{false};          //!< producer thread has ended
+};
+
+} // end namespace cbm
+
+#include "LoggerBinBuffer.ipp"
+
+#endif
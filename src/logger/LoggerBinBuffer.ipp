@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include <cstring>
+
+namespace cbm {
+
+//-----------------------------------------------------------------------------
+/*! \brief Reserve space for a record (producer only)
+  \param nbyte   size of the record body
+  \returns pointer to the record body, or `nullptr` if the buffer is full,
+    in that case the record is counted as dropped
+
+  The record becomes visible to the consumer with Commit(). The body is
+  8 byte aligned.
+ */
+
+inline char* LoggerBinBuffer::Reserve(size_t nbyte) {
+  uint64_t head = fHead.load(memory_order_relaxed);
+  uint64_t off = head & (fSize - 1);
+  uint64_t recsize = RecordSize(nbyte);
+  uint64_t npad = off + recsize > fSize ? fSize - off : 0;
+  if (head + npad + recsize - fTailCache > fSize) {
+    fTailCache = fTail.load(memory_order_acquire);
+    if (head + npad + recsize - fTailCache > fSize) {
+      fNDrop.fetch_add(1, memory_order_relaxed);
+      return nullptr;
+    }
+  }
+  uint32_t len = uint32_t(nbyte);
+  if (npad > 0) { // pad record up to end of data area, record at begin
+    uint32_t padmark = 0xffffffffU;
+    memcpy(fData.get() + off, &padmark, sizeof(padmark));
+    off = 0;
+  }
+  memcpy(fData.get() + off, &len, sizeof(len));
+  fPendHead = head + npad + recsize;
+  return fData.get() + off + 8;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Publish the record reserved with Reserve() (producer only)
+  \returns `true` if the buffer is more than half full
+ */
+
+inline bool LoggerBinBuffer::Commit() {
+  fHead.store(fPendHead, memory_order_release);
+  if (fPendHead - fTailCache <= fSize / 2)
+    return false;
+  fTailCache = fTail.load(memory_order_acquire); // estimate might be stale
+  return fPendHead - fTailCache > fSize / 2;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the name of the producer thread at buffer creation
+
+inline const string& LoggerBinBuffer::ThreadName() const { return fThreadName; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` when Retire() was called
+
+inline bool LoggerBinBuffer::Retired() const {
+  return fRetired.load(memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the size of a record with an `nbyte` body
+
+inline uint64_t LoggerBinBuffer::RecordSize(size_t nbyte) {
+  return (8 + nbyte + 7) & ~uint64_t(7);
+}
+
+} // end namespace cbm
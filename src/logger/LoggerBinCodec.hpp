@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_LoggerBinCodec
+#define included_Cbm_LoggerBinCodec 1
+
+#include "ChronoDefs.hpp"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace cbm {
+using namespace std;
+
+/*! \struct LoggerBinSite
+  \brief Static context of a CBMLOGBIN() call site
+*/
+
+struct LoggerBinSite {
+  int fSevId;        //!< severity
+  const char* fKeys; //!< primary environment keys
+  const char* fMid;  //!< \glos{messageid}
+};
+
+class LoggerBinCodec {
+public:
+  using format_fn = void (*)(const char* fmtstr, const char* args, string& out);
+
+  struct Header {
+    format_fn fFormat;          //!< formatter for the argument types
+    const LoggerBinSite* fSite; //!< call site context
+    const char* fFmtStr;        //!< format string
+    sctime_point fTime;         //!< timestamp
+  };
+
+  template <typename... Args> static size_t Size(const Args&... args);
+  template <typename... Args> static void Put(char* pbuf, const Args&... args);
+  template <typename... Args>
+  static void Format(const char* fmtstr, const char* args, string& out);
+
+private:
+  template <typename T>
+  using arg_t = conditional_t<is_arithmetic_v<T>, T, string_view>;
+
+  template <typename T> static size_t ArgSize(const T& val);
+  template <typename T> static void PutArg(char*& pbuf, const T& val);
+  template <typename T> static arg_t<T> GetArg(const char*& pbuf);
+};
+
+} // end namespace cbm
+
+#include "LoggerBinCodec.ipp"
+
+#endif
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "fmt/format.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+
+namespace cbm {
+
+/*! \class LoggerBinCodec
+  \brief Encodes CBMLOGBIN() arguments in binary form, formats them later
+
+  A binary record consists of a Header followed by the raw arguments.
+  Arithmetic arguments are stored with `memcpy`, string arguments as 32 bit
+  length followed by the characters. The Header holds a pointer to
+  Format() instantiated for the argument types, so the reader of a record
+  does not need any other type information.
+*/
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the size of the encoded record for `args`
+
+template <typename... Args>
+inline size_t LoggerBinCodec::Size(const Args&... args) {
+  return (sizeof(Header) + ... + ArgSize(args));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Encodes `args` after the Header at `pbuf`
+
+  The Header must be stored separately by the caller.
+ */
+
+template <typename... Args>
+inline void LoggerBinCodec::Put(char* pbuf, const Args&... args) {
+  pbuf += sizeof(Header);
+  (PutArg(pbuf, args), ...);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Decodes the arguments at `args` and appends the formatted text
+  \param fmtstr   `fmt` format string
+  \param args     encoded arguments, as written by Put()
+  \param out      string to which the text is appended
+  \throws fmt::format_error if `fmtstr` does not fit the arguments
+ */
+
+template <typename... Args>
+inline void LoggerBinCodec::Format(const char* fmtstr,
+                                   const char* args,
+                                   string& out) {
+  (void)args; // unused when no arguments
+  // braced init guarantees left to right evaluation of the GetArg()s
+  tuple<arg_t<Args>...> vals{GetArg<Args>(args)...};
+  apply(
+      [&](const auto&... val) {
+        fmt::format_to(back_inserter(out), fmt::runtime(fmtstr), val...);
+      },
+      vals);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the encoded size of an argument
+
+template <typename T> inline size_t LoggerBinCodec::ArgSize(const T& val) {
+  static_assert(is_arithmetic_v<T> || is_convertible_v<const T&, string_view>,
+                "CBMLOGBIN supports only arithmetic and string arguments");
+  if constexpr (is_arithmetic_v<T>) {
+    return sizeof(T);
+  } else if constexpr (is_pointer_v<T>) {
+    return sizeof(uint32_t) + (val ? strlen(val) : 0);
+  } else {
+    return sizeof(uint32_t) + string_view(val).size();
+  }
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Encodes an argument and advances `pbuf`
+
+template <typename T>
+inline void LoggerBinCodec::PutArg(char*& pbuf, const T& val) {
+  if constexpr (is_arithmetic_v<T>) {
+    memcpy(pbuf, &val, sizeof(T));
+    pbuf += sizeof(T);
+  } else {
+    string_view sval;
+    if constexpr (is_pointer_v<T>) {
+      if (val)
+        sval = val;
+    } else {
+      sval = val;
+    }
+    uint32_t len = uint32_t(sval.size());
+    memcpy(pbuf, &len, sizeof(len));
+    memcpy(pbuf + sizeof(len), sval.data(), len);
+    pbuf += sizeof(len) + len;
+  }
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Decodes an argument and advances `pbuf`
+
+template <typename T>
+inline LoggerBinCodec::arg_t<T> LoggerBinCodec::GetArg(const char*& pbuf) {
+  if constexpr (is_arithmetic_v<T>) {
+    T val;
+    memcpy(&val, pbuf, sizeof(T));
+    pbuf += sizeof(T);
+    return val;
+  } else {
+    uint32_t len = 0;
+    memcpy(&len, pbuf, sizeof(len));
+    string_view sval(pbuf + sizeof(len), len);
+    pbuf += sizeof(len) + len;
+    return sval;
+  }
+}
+
+} // end namespace cbm
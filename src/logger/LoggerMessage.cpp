@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "LoggerMessage.hpp"
+
+namespace cbm {
+using namespace std;
+
+//-----------------------------------------------------------------------------
+/*! \brief Index the `key=value` entries of the key set
+
+  The key set is split at ',', entries without '=' or with an empty key
+  name are not indexed, they are only visible in Keys().
+ */
+
+void LoggerMessage::IndexKeys() {
+  string_view keys = Keys();
+  size_t pbeg = 0;
+  while (pbeg < keys.size()) {
+    size_t pend = keys.find(',', pbeg);
+    if (pend == string_view::npos)
+      pend = keys.size();
+    size_t peq = keys.substr(0, pend).find('=', pbeg);
+    if (peq != string_view::npos && peq > pbeg) {
+      KeySpan span{uint32_t(pbeg), uint32_t(peq), uint32_t(pend)};
+      if (fNKeys < kNKeyInline) {
+        fKeySpans[fNKeys] = span;
+      } else {
+        fKeySpansMore.push_back(span);
+      }
+      fNKeys += 1;
+    }
+    pbeg = pend + 1;
+  }
+}
+
+} // end namespace cbm
@@ -7,12 +7,26 @@
 
 #include "ChronoDefs.hpp"
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace cbm {
 
 /*! \struct LoggerMessage
   \brief Holds the context of a Logger message
+
+  Key set and message body are held in one string `fText`, the key set
+  being the first `fKeysSize` characters. Use Keys() and Message() to
+  access them.
+
+  The `key=value` entries of the key set are indexed when the message is
+  constructed. They are available via NKeys(), KeyName(), KeyValue() and
+  Key() as views into `fText`, without splitting the key set into separate
+  strings. The index holds offsets, so it stays valid when the message is
+  moved. The first kNKeyInline entries are stored in the message itself,
+  only a longer key set allocates.
 */
 
 struct LoggerMessage {
@@ -20,20 +34,48 @@ struct LoggerMessage {
   LoggerMessage(const sctime_point& time,
                 int sev,
                 string&& tname,
-                string&& keys,
-                string&& text)
-      : fTime(time), fSevId(sev), fThreadName(move(tname)), fKeys(move(keys)),
-        fMessage(move(text)) {}
+                string&& text,
+                size_t nkeys)
+      : fTime(time), fSevId(sev), fThreadName(move(tname)), fText(move(text)),
+        fKeysSize(nkeys) {
+    IndexKeys();
+  }
   LoggerMessage(const LoggerMessage& rhs) = delete;
   LoggerMessage(LoggerMessage&& rhs) = default;
+  LoggerMessage& operator=(LoggerMessage&& rhs) = default;
+
+  string_view Keys() const;
+  string_view Message() const;
+  size_t NKeys() const;
+  string_view KeyName(size_t i) const;
+  string_view KeyValue(size_t i) const;
+  string_view Key(string_view name) const;
+
+  struct KeySpan {
+    uint32_t fBeg; //!< offset of key name in fText
+    uint32_t fEq;  //!< offset of '=' in fText
+    uint32_t fEnd; //!< offset behind value in fText
+  };
 
-  sctime_point fTime{};   //!< timestamp
-  int fSevId{0};          //!< severity
-  string fThreadName{""}; //!< thread name
-  string fKeys{""};       //!< key set
-  string fMessage{""};    //!< message body
+  // some constants
+  static const size_t kNKeyInline = 6; //!< # of entries stored inline
+
+  sctime_point fTime{};             //!< timestamp
+  int fSevId{0};                    //!< severity
+  string fThreadName{""};           //!< thread name
+  string fText{""};                 //!< key set followed by message body
+  size_t fKeysSize{0};              //!< length of key set in fText
+  size_t fNKeys{0};                 //!< # of indexed key set entries
+  KeySpan fKeySpans[kNKeyInline]{}; //!< first key set entries
+  vector<KeySpan> fKeySpansMore{};  //!< further key set entries
+
+private:
+  void IndexKeys();
+  const KeySpan& Span(size_t i) const;
 };
 
 } // end namespace cbm
 
+#include "LoggerMessage.ipp"
+
 #endif
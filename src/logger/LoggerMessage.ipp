@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the key set, a comma separated list of `key=value`
+
+inline string_view LoggerMessage::Keys() const {
+  return string_view(fText).substr(0, fKeysSize);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the message body
+
+inline string_view LoggerMessage::Message() const {
+  return string_view(fText).substr(fKeysSize);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the number of indexed `key=value` entries of the key set
+
+inline size_t LoggerMessage::NKeys() const { return fNKeys; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the name of the `i`-th key set entry
+
+inline string_view LoggerMessage::KeyName(size_t i) const {
+  const KeySpan& span = Span(i);
+  return string_view(fText).substr(span.fBeg, span.fEq - span.fBeg);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the value of the `i`-th key set entry
+
+inline string_view LoggerMessage::KeyValue(size_t i) const {
+  const KeySpan& span = Span(i);
+  return string_view(fText).substr(span.fEq + 1, span.fEnd - span.fEq - 1);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the value of the first key set entry named `name`, or ""
+
+inline string_view LoggerMessage::Key(string_view name) const {
+  for (size_t i = 0; i < fNKeys; i++)
+    if (KeyName(i) == name)
+      return KeyValue(i);
+  return string_view();
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the index entry of the `i`-th key set entry
+
+inline const LoggerMessage::KeySpan& LoggerMessage::Span(size_t i) const {
+  return i < kNKeyInline ? fKeySpans[i] : fKeySpansMore[i - kNKeyInline];
+}
+
+} // end namespace cbm
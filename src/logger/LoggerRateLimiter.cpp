@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "LoggerRateLimiter.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Logger.hpp"
+#include "PThreadHelper.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+
+namespace cbm {
+using namespace std;
+
+/*! \class LoggerRateLimiter
+  \brief Token bucket rate limiting of Logger messages
+
+  Limits the rate of messages with the same severity, environment keys and
+  \glos{messageid}. Each such series has a token bucket which admits a
+  sustained `rate` of messages per second and bursts of up to `burst`
+  messages. The buckets use the generic cell rate algorithm, a bucket is a
+  single `atomic` timestamp which is updated with a compare and swap, so
+  Admit() takes no lock.
+
+  The series are hashed into a fixed table of kNSlot buckets, series with
+  colliding hashes share a bucket. Suppressed messages are counted per
+  bucket. The keys of the first suppressed message of a period are kept,
+  and Report() creates for each bucket with suppressed messages one
+  summary message with these keys, the severity of the suppressed
+  messages, and the number of suppressed messages. The keys are written
+  under the bucket mutex before the count becomes non-zero, later
+  suppressions only increment a non-zero count, so Report() always sees a
+  count together with the keys of its period.
+
+  `Fatal` messages are never suppressed.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Configure the limiter
+  \param rate    sustained rate in messages per second, `0` disables
+  \param burst   number of messages admitted in a burst, at least 1
+ */
+
+void LoggerRateLimiter::Configure(double rate, double burst) {
+  lock_guard<mutex> lock(fConfigMutex);
+  if (rate <= 0.) {
+    fInterval.store(0, memory_order_release);
+    return;
+  }
+  if (!fSlots)
+    fSlots = make_unique<Slot[]>(kNSlot);
+  int64_t interval = max(int64_t(1), int64_t(1.e9 / rate));
+  fTolerance.store(int64_t(double(interval) * (max(burst, 1.) - 1.)),
+                   memory_order_relaxed);
+  fInterval.store(interval, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Check whether a message is admitted
+  \param sev     message severity
+  \param keys1   primary environment keys
+  \param mid     message id
+  \param keys2   seconday environment keys
+  \returns `false` if the message should be suppressed
+ */
+
+bool LoggerRateLimiter::Admit(int sev,
+                              const string& keys1,
+                              const string& mid,
+                              const string& keys2) {
+  int64_t interval = fInterval.load(memory_order_acquire);
+  if (interval == 0 || sev >= Logger::kLogFatal)
+    return true;
+  int64_t tolerance = fTolerance.load(memory_order_relaxed);
+  Slot& slot = fSlots[Hash(sev, keys1, mid, keys2) & (kNSlot - 1)];
+  int64_t now = chrono::duration_cast<chrono::nanoseconds>(
+                    chrono::steady_clock::now().time_since_epoch())
+                    .count();
+
+  int64_t tat = slot.fTat.load(memory_order_relaxed);
+  while (true) {
+    int64_t base = max(tat, now);
+    if (base - now > tolerance)
+      break; // bucket empty
+    if (slot.fTat.compare_exchange_weak(tat, base + interval,
+                                        memory_order_relaxed))
+      return true;
+  }
+
+  // suppressed, count without lock while the period already has a context
+  uint64_t nsup = slot.fNSuppress.load(memory_order_relaxed);
+  while (nsup != 0) {
+    if (slot.fNSuppress.compare_exchange_weak(nsup, nsup + 1,
+                                              memory_order_relaxed))
+      return false;
+  }
+
+  // first one in the report period, keep context, then make count visible
+  lock_guard<mutex> lock(slot.fMutex);
+  if (slot.fNSuppress.load(memory_order_relaxed) == 0) {
+    slot.fSevId = sev;
+    slot.fThreadName = PThreadName();
+    slot.fKeys = keys1;
+    if (mid.length())
+      slot.fKeys += ",mid=" + mid;
+    if (keys2.length()) {
+      string_view keys2sv(keys2); // view with dropped trailing ','
+      if (keys2sv[keys2sv.length() - 1] == ',')
+        keys2sv.remove_suffix(1);
+      slot.fKeys += ",";
+      slot.fKeys += keys2sv;
+    }
+  }
+  slot.fNSuppress.fetch_add(1, memory_order_relaxed);
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Create summary messages for suppressed messages
+  \param msgvec   message vector to which the summaries are appended
+  \param period   length of the report period in s, used in the text
+ */
+
+void LoggerRateLimiter::Report(vector<LoggerMessage>& msgvec, double period) {
+  lock_guard<mutex> cfglock(fConfigMutex);
+  if (!fSlots)
+    return;
+  for (size_t i = 0; i < kNSlot; i++) {
+    Slot& slot = fSlots[i];
+    if (slot.fNSuppress.load(memory_order_relaxed) == 0)
+      continue;
+    lock_guard<mutex> lock(slot.fMutex);
+    uint64_t nsup = slot.fNSuppress.exchange(0, memory_order_acq_rel);
+    string text = slot.fKeys;
+    size_t nkeys = text.size();
+    text += fmt::format("message repeated {} times, suppressed by rate limit"
+                        " in last {:.0f} s",
+                        nsup, period);
+    msgvec.emplace_back(ScNow(), slot.fSevId, string(slot.fThreadName),
+                        move(text), nkeys);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns hash of the series identity of a message (FNV-1a)
+ */
+
+uint64_t LoggerRateLimiter::Hash(int sev,
+                                 const string& keys1,
+                                 const string& mid,
+                                 const string& keys2) {
+  uint64_t hash = 0xcbf29ce484222325ULL ^ uint64_t(sev);
+  for (const string* pstr : {&keys1, &mid, &keys2}) {
+    for (char c : *pstr)
+      hash = (hash ^ uint8_t(c)) * 0x100000001b3ULL;
+    hash = (hash ^ 0xff) * 0x100000001b3ULL; // separator
+  }
+  return hash;
+}
+
+} // end namespace cbm
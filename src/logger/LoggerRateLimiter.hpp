@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_LoggerRateLimiter
+#define included_Cbm_LoggerRateLimiter 1
+
+#include "LoggerMessage.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cbm {
+using namespace std;
+
+class LoggerRateLimiter {
+public:
+  LoggerRateLimiter() = default;
+
+  LoggerRateLimiter(const LoggerRateLimiter&) = delete;
+  LoggerRateLimiter& operator=(const LoggerRateLimiter&) = delete;
+
+  void Configure(double rate, double burst);
+  bool Enabled() const;
+  bool Admit(int sev,
+             const string& keys1,
+             const string& mid,
+             const string& keys2);
+  void Report(vector<LoggerMessage>& msgvec, double period);
+
+  // some constants
+  static const size_t kNSlot = 4096; //!< # of buckets, power of 2
+
+private:
+  struct Slot {
+    atomic<int64_t> fTat{0};        //!< theoretical arrival time in ns
+    atomic<uint64_t> fNSuppress{0}; //!< # of suppressed since last report
+    mutex fMutex{};                 //!< protects context below
+    int fSevId{0};                  //!< severity of first suppressed
+    string fThreadName{};           //!< thread of first suppressed
+    string fKeys{};                 //!< keys of first suppressed
+  };
+
+  static uint64_t Hash(int sev,
+                       const string& keys1,
+                       const string& mid,
+                       const string& keys2);
+
+private:
+  unique_ptr<Slot[]> fSlots{};   //!< bucket table, created by Configure()
+  atomic<int64_t> fInterval{0};  //!< ns per message, 0 when disabled
+  atomic<int64_t> fTolerance{0}; //!< burst allowance in ns
+  mutex fConfigMutex{};          //!< serializes Configure()
+};
+
+} // end namespace cbm
+
+#include "LoggerRateLimiter.ipp"
+
+#endif
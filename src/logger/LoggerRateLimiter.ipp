@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` if rate limiting is active
+
+inline bool LoggerRateLimiter::Enabled() const {
+  return fInterval.load(memory_order_acquire) != 0;
+}
+
+} // end namespace cbm
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "LoggerRecorder.hpp"
+
+#include "Exception.hpp"
+#include "SysCallException.hpp"
+
+#include "fmt/format.h"
+
+#include <new>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const uint64_t kMagic = 0x434552474c4d4243ULL; // "CBMLGREC"
+static const uint32_t kVersion = 1;                   // layout version
+
+static_assert(atomic<uint64_t>::is_always_lock_free,
+              "flight recorder requires lock-free 64 bit atomics");
+
+/*! \class LoggerRecorder
+  \brief Flight recorder for Logger messages in a memory mapped file
+
+  Keeps the most recent Logger messages in a ring of fixed size slots in a
+  file mapped with `MAP_SHARED`. The file content is in the page cache and
+  is written back by the kernel, so it survives a crash of the process and
+  can be decoded afterwards, e.g. with the `logger_recdump` tool.
+
+  Any thread can record. Record() claims the next slot by incrementing the
+  `head` counter with one atomic operation and copies the message into the
+  slot, no lock is taken and no system call is done. Messages longer than
+  the slot are truncated.
+
+  Each slot holds a sequence number, which is the record index plus one
+  when the slot is complete and zero while it is written. Snapshot() only
+  returns slots with the expected sequence number, which didn't change
+  while they were copied, so torn records are skipped.
+
+  The file is allocated with `posix_fallocate(3)` and zero filled when
+  created. So no `SIGBUS` is raised later for a full file system and the
+  recording does not pay for page faults.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor for the writer, creates the file
+  \param path       file name, an existing file is renamed to `path.prev`
+  \param size       size of the ring, rounded up to a power of 2 slots
+  \param slotsize   size of a slot, a power of 2 from 64 to 32768
+  \param progname   program name, stored in the header
+  \param hostname   host name, stored in the header
+  \throws Exception if `slotsize` is invalid
+  \throws SysCallException in case a system call fails
+
+  The file of a previous run, e.g. of a crashed process restarted by a
+  supervisor, is kept as `path.prev`, so it can still be decoded.
+ */
+
+LoggerRecorder::LoggerRecorder(const string& path,
+                               size_t size,
+                               size_t slotsize,
+                               const string& progname,
+                               const string& hostname)
+    : fPath(path), fSlotSize(slotsize) {
+  if (slotsize < 64 || slotsize > 32768 || (slotsize & (slotsize - 1)) != 0)
+    throw Exception(fmt::format("LoggerRecorder::ctor: invalid slot size {}",
+                                slotsize));
+  size_t nslot = 16;
+  while (nslot * slotsize < size)
+    nslot *= 2;
+  fSlotMask = nslot - 1;
+
+  string pname = fPath + ".prev";
+  if (::rename(fPath.c_str(), pname.c_str()) < 0 && errno != ENOENT)
+    throw SysCallException("LoggerRecorder::ctor"s, "rename"s, fPath, errno);
+  int fd = ::open(fPath.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC,
+                  0640);
+  if (fd < 0)
+    throw SysCallException("LoggerRecorder::ctor"s, "open"s, fPath, errno);
+  size_t mapsize = sizeof(Header) + nslot * slotsize;
+  if (int rc = ::posix_fallocate(fd, 0, off_t(mapsize)); rc != 0) {
+    (void)::close(fd);
+    throw SysCallException("LoggerRecorder::ctor"s, "posix_fallocate"s, fPath,
+                           rc);
+  }
+  Map(fd, mapsize, true);
+
+  // zero fill, also pre-faults all pages
+  memset(static_cast<void*>(fpHeader), 0, fMapSize);
+  new (fpHeader) Header{};
+  fpHeader->fVersion = kVersion;
+  fpHeader->fSlotSize = uint32_t(slotsize);
+  fpHeader->fNSlot = nslot;
+  fpHeader->fWriterPid = ::getpid();
+  progname.copy(fpHeader->fProgName, sizeof(fpHeader->fProgName) - 1);
+  hostname.copy(fpHeader->fHostName, sizeof(fpHeader->fHostName) - 1);
+  fpHeader->fMagic = kMagic;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor for a reader, maps an existing file read-only
+  \param path       file name
+  \throws SysCallException in case a system call fails
+  \throws Exception if the file is not a recorder file of this version
+ */
+
+LoggerRecorder::LoggerRecorder(const string& path) : fPath(path) {
+  int fd = ::open(fPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    throw SysCallException("LoggerRecorder::ctor"s, "open"s, fPath, errno);
+  struct stat sbuf;
+  if (::fstat(fd, &sbuf) < 0) {
+    int eno = errno;
+    (void)::close(fd);
+    throw SysCallException("LoggerRecorder::ctor"s, "fstat"s, fPath, eno);
+  }
+  if (size_t(sbuf.st_size) <= sizeof(Header)) {
+    (void)::close(fd);
+    throw Exception(
+        fmt::format("LoggerRecorder::ctor: file '{}' too small", fPath));
+  }
+  Map(fd, size_t(sbuf.st_size), false);
+  const Header& hdr = *fpHeader;
+  if (hdr.fMagic != kMagic || hdr.fVersion != kVersion ||
+      hdr.fSlotSize < 64 || (hdr.fNSlot & (hdr.fNSlot - 1)) != 0 ||
+      sizeof(Header) + hdr.fNSlot * hdr.fSlotSize != fMapSize)
+    throw Exception(fmt::format("LoggerRecorder::ctor: file '{}' is not a"
+                                " recorder file of version {}",
+                                fPath, kVersion));
+  fSlotSize = hdr.fSlotSize;
+  fSlotMask = hdr.fNSlot - 1;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor, unmaps the file
+ */
+
+LoggerRecorder::~LoggerRecorder() {
+  if (fpHeader)
+    (void)::munmap(fpHeader, fMapSize);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Appends the recorded messages, oldest first
+  \param msgvec   message vector to which the messages are appended
+  \param from     index of the first record to return
+  \returns index after the last returned record, use as `from` next time
+
+  Can be called while other threads record, slots being written are
+  skipped.
+ */
+
+uint64_t LoggerRecorder::Snapshot(vector<LoggerMessage>& msgvec,
+                                  uint64_t from) const {
+  uint64_t head = NRecord();
+  uint64_t nslot = fSlotMask + 1;
+  uint64_t beg = max(head > nslot ? head - nslot : 0, from);
+  size_t ntextmax = fSlotSize - sizeof(Slot);
+
+  for (uint64_t idx = beg; idx < head; idx++) {
+    const Slot& slot = SlotRef(idx);
+    if (slot.fSeq.load(memory_order_acquire) != idx + 1)
+      continue; // being written, torn or already overwritten
+    Slot copy;
+    memcpy(static_cast<void*>(&copy), &slot, sizeof(Slot));
+    size_t ntext = min(size_t(copy.fTextSize), ntextmax);
+    string text(reinterpret_cast<const char*>(&slot) + sizeof(Slot), ntext);
+    atomic_thread_fence(memory_order_acquire);
+    if (slot.fSeq.load(memory_order_relaxed) != idx + 1)
+      continue; // overwritten while copied
+    string tname(copy.fThreadName,
+                 strnlen(copy.fThreadName, sizeof(copy.fThreadName)));
+    msgvec.emplace_back(Nsec2ScTimePoint(copy.fTime), copy.fSevId,
+                        move(tname), move(text),
+                        min(size_t(copy.fKeysSize), ntext));
+  }
+  return head;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the program name of the writer
+
+string LoggerRecorder::ProgName() const {
+  const char* str = fpHeader->fProgName;
+  return string(str, strnlen(str, sizeof(fpHeader->fProgName)));
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the host name of the writer
+
+string LoggerRecorder::HostName() const {
+  const char* str = fpHeader->fHostName;
+  return string(str, strnlen(str, sizeof(fpHeader->fHostName)));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Maps the file and closes the fd
+ */
+
+void LoggerRecorder::Map(int fd, size_t size, bool write) {
+  int prot = write ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* addr = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+  int eno = errno;
+  (void)::close(fd);
+  if (addr == MAP_FAILED)
+    throw SysCallException("LoggerRecorder::Map"s, "mmap"s, fPath, eno);
+  fpHeader = static_cast<Header*>(addr);
+  fMapSize = size;
+  fpData = static_cast<char*>(addr) + sizeof(Header);
+}
+
+} // end namespace cbm
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_LoggerRecorder
+#define included_Cbm_LoggerRecorder 1
+
+#include "ChronoDefs.hpp"
+#include "LoggerMessage.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace cbm {
+using namespace std;
+
+class LoggerRecorder {
+public:
+  LoggerRecorder(const string& path,
+                 size_t size,
+                 size_t slotsize,
+                 const string& progname,
+                 const string& hostname);
+  explicit LoggerRecorder(const string& path);
+  ~LoggerRecorder();
+
+  LoggerRecorder(const LoggerRecorder&) = delete;
+  LoggerRecorder& operator=(const LoggerRecorder&) = delete;
+
+  void Record(const sctime_point& time,
+              int sev,
+              string_view tname,
+              string_view text,
+              size_t nkeys);
+  uint64_t Snapshot(vector<LoggerMessage>& msgvec, uint64_t from = 0) const;
+
+  const string& Path() const;
+  uint64_t NRecord() const;
+  size_t NSlot() const;
+  pid_t WriterPid() const;
+  string ProgName() const;
+  string HostName() const;
+
+private:
+  struct Header {
+    uint64_t fMagic;                    //!< identifies a recorder file
+    uint32_t fVersion;                  //!< layout version
+    uint32_t fSlotSize;                 //!< size of a slot, power of 2
+    uint64_t fNSlot;                    //!< # of slots, power of 2
+    int64_t fWriterPid;                 //!< pid of writer process
+    char fProgName[64];                 //!< program name of writer
+    char fHostName[64];                 //!< host name of writer
+    alignas(64) atomic<uint64_t> fHead; //!< # of records ever started
+  };
+
+  struct Slot {
+    atomic<uint64_t> fSeq; //!< record index + 1, 0 while written
+    int64_t fTime;         //!< time stamp, ns since epoch
+    int32_t fSevId;        //!< severity
+    uint16_t fKeysSize;    //!< length of key set in text
+    uint16_t fTextSize;    //!< length of stored text
+    char fThreadName[16];  //!< thread name, 0 terminated if shorter
+  };
+
+  void Map(int fd, size_t size, bool write);
+  Slot& SlotRef(uint64_t idx) const;
+
+private:
+  string fPath;              //!< file name
+  Header* fpHeader{nullptr}; //!< mapped file
+  size_t fMapSize{0};        //!< size of mapping
+  char* fpData{nullptr};     //!< first slot
+  size_t fSlotSize{0};       //!< size of a slot
+  uint64_t fSlotMask{0};     //!< # of slots - 1
+};
+
+} // end namespace cbm
+
+#include "LoggerRecorder.ipp"
+
+#endif
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "ChronoHelper.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cbm {
+
+//-----------------------------------------------------------------------------
+/*! \brief Record a message, can be called from any thread
+  \param time    time stamp
+  \param sev     severity
+  \param tname   thread name, truncated to 16 characters
+  \param text    key set followed by message body
+  \param nkeys   length of key set in `text`
+
+  Claims the next slot with one atomic increment and copies the message
+  into it, `text` is truncated to the slot size. The slot is marked
+  invalid while it is written, so a record torn by a crash or by a
+  concurrent overwrite is skipped by Snapshot().
+ */
+
+inline void LoggerRecorder::Record(const sctime_point& time,
+                                   int sev,
+                                   string_view tname,
+                                   string_view text,
+                                   size_t nkeys) {
+  uint64_t idx = fpHeader->fHead.fetch_add(1, memory_order_relaxed);
+  Slot& slot = SlotRef(idx);
+  slot.fSeq.store(0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  size_t ntext = min(text.size(), fSlotSize - sizeof(Slot));
+  size_t nname = min(tname.size(), sizeof(slot.fThreadName));
+  slot.fTime = ScTimePoint2Nsec(time);
+  slot.fSevId = sev;
+  slot.fKeysSize = uint16_t(min(nkeys, ntext));
+  slot.fTextSize = uint16_t(ntext);
+  memcpy(slot.fThreadName, tname.data(), nname);
+  if (nname < sizeof(slot.fThreadName))
+    slot.fThreadName[nname] = 0;
+  memcpy(reinterpret_cast<char*>(&slot) + sizeof(Slot), text.data(), ntext);
+  slot.fSeq.store(idx + 1, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the file name
+
+inline const string& LoggerRecorder::Path() const { return fPath; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the number of records written since creation
+
+inline uint64_t LoggerRecorder::NRecord() const {
+  return fpHeader->fHead.load(memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the number of slots, the maximal number of kept records
+
+inline size_t LoggerRecorder::NSlot() const { return fSlotMask + 1; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the pid of the writer process
+
+inline pid_t LoggerRecorder::WriterPid() const {
+  return pid_t(fpHeader->fWriterPid);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the slot for record index `idx`
+
+inline LoggerRecorder::Slot& LoggerRecorder::SlotRef(uint64_t idx) const {
+  return *reinterpret_cast<Slot*>(fpData + (idx & fSlotMask) * fSlotSize);
+}
+
+} // end namespace cbm
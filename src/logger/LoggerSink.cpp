@@ -14,6 +14,10 @@ using namespace std;
   Concrete implementations are
   - LoggerSinkFile: concrete sink for file output
   - LoggerSinkSysLog: concrete sink for syslog(3) output
+  - LoggerSinkDevlog: concrete sink for direct syslog socket output
+
+  The sink path may carry options as `path?key=value&...`, they are made
+  available to the concrete sinks via `fOptions`, see SinkOptions.
 */
 
 //-----------------------------------------------------------------------------
@@ -24,6 +28,16 @@ using namespace std;
  */
 
 LoggerSink::LoggerSink(Logger& logger, const string& path, int lvl)
-    : fLogger(logger), fSinkPath(path), fLogLevel(lvl) {}
+    : fLogger(logger), fSinkPath(path), fOptions(path), fLogLevel(lvl) {}
+
+//-----------------------------------------------------------------------------
+/*! \brief Periodic hook, called by the Logger work thread
+
+  Called after each processing round, with or without messages, so at
+  least every Logger::kELoopTimeout ms. Allows sinks to do time driven
+  work, like LoggerSinkMonitor in aggregated mode. The default does nothing.
+ */
+
+void LoggerSink::ProcessHeartbeat() {}
 
 } // end namespace cbm
@@ -6,6 +6,7 @@
 #define included_Cbm_LoggerSink 1
 
 #include "LoggerMessage.hpp"
+#include "SinkOptions.hpp"
 
 #include <string>
 #include <vector>
@@ -21,14 +22,16 @@ public:
   virtual ~LoggerSink() = default;
 
   virtual void ProcessMessageVec(const vector<LoggerMessage>& msgvec) = 0;
+  virtual void ProcessHeartbeat();
 
   void SetLogLevel(int lvl);
   int LogLevel() const;
 
 protected:
-  Logger& fLogger;  //!< back reference to Logger
-  string fSinkPath; //!< path for output
-  int fLogLevel;    //!< \glos{loglevel} for write
+  Logger& fLogger;      //!< back reference to Logger
+  string fSinkPath;     //!< path for output
+  SinkOptions fOptions; //!< path and options split from fSinkPath
+  int fLogLevel;        //!< \glos{loglevel} for write
 };
 
 } // end namespace cbm
@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "LoggerSinkDevlog.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "Logger.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const char* const kDefPath = "/dev/log"; // default socket path
+static const size_t kSendBatch = 256; // max datagrams per sendmmsg() call
+static const double kTimeout = 1.;    // default send timeout in sec
+
+static const pair<const char*, int> kFacilities[] = {
+    {"user", LOG_USER},     {"daemon", LOG_DAEMON}, {"local0", LOG_LOCAL0},
+    {"local1", LOG_LOCAL1}, {"local2", LOG_LOCAL2}, {"local3", LOG_LOCAL3},
+    {"local4", LOG_LOCAL4}, {"local5", LOG_LOCAL5}, {"local6", LOG_LOCAL6},
+    {"local7", LOG_LOCAL7}};
+
+static const char* const kMonths[] = {"Jan", "Feb", "Mar", "Apr",
+                                      "May", "Jun", "Jul", "Aug",
+                                      "Sep", "Oct", "Nov", "Dec"};
+
+/*! \class LoggerSinkDevlog
+  \brief Logger sink - concrete sink for direct output to the syslog socket
+
+  Writes messages like LoggerSinkSyslog, but without `syslog(3)`. The sink
+  has its own connection to the `/dev/log` socket of the syslog daemon
+  (`rsyslog` or `systemd-journald`), formats the syslog datagrams of all
+  messages of a batch into one buffer and sends them with few
+  `sendmmsg(2)` calls. `syslog(3)` instead takes a global lock, formats the
+  timestamp and does one `send(2)` for each message.
+
+  The datagrams are in [RFC 3164](https://www.rfc-editor.org/rfc/rfc3164)
+  format, as generated by `syslog(3)`, or in
+  [RFC 5424](https://www.rfc-editor.org/rfc/rfc5424) format, which carries
+  a timestamp with microsecond precision and time zone, and the host name.
+  The message body is the same as for LoggerSinkSyslog. The severity
+  mapping is also the same, kLogTrace and kLogDebug map to LOG_DEBUG and
+  kLogFatal to LOG_ERR.
+
+  The socket is blocking with a send timeout, so the Logger thread waits
+  when the syslog daemon is busy, but not forever. When the syslog daemon
+  is restarted the socket is re-created and sends fail with
+  `ECONNREFUSED`. The sink reconnects immediately, if that fails the
+  messages are dropped and a connect is retried after the `retry` period.
+  Dropped messages are counted and reported on `std::cerr` once the
+  connection is back.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param logger back reference to Logger
+  \param path   socket path and options
+  \param lvl    \glos{loglevel} for writing
+  \throws Exception in case of invalid options
+
+  The socket path defaults to `/dev/log` when empty. It can be followed by
+  `?` and these options
+  - `format`: `rfc3164` (default) or `rfc5424`
+  - `facility`: syslog facility, `user`, `daemon` or `local0` to `local7`
+    (default `local1`)
+  - `ident`: the TAG or APP-NAME field (default `cbm`)
+  - `timeout`: send timeout in sec (default 1.)
+  - `retry`: period of reconnect attempts in sec (default 1.)
+
+  Several LoggerSinkDevlog sinks can be opened, e.g. with different
+  facilities or \glos{loglevel} settings. A failing connect is reported but
+  not fatal, the sink retries later.
+ */
+
+LoggerSinkDevlog::LoggerSinkDevlog(Logger& logger, const string& path,
+                                   int lvl)
+    : LoggerSink(logger, path, lvl) {
+  fOptions.Check("LoggerSinkDevlog::ctor",
+                 {"format", "facility", "ident", "timeout", "retry"});
+  fSockPath = fOptions.Path().empty() ? kDefPath : fOptions.Path();
+  if (fSockPath.size() >= sizeof(sockaddr_un::sun_path))
+    throw Exception(fmt::format("LoggerSinkDevlog::ctor: socket path '{}'"
+                                " too long",
+                                fSockPath));
+
+  string format = fOptions.String("format", "rfc3164");
+  if (format != "rfc3164" && format != "rfc5424")
+    throw Exception(fmt::format("LoggerSinkDevlog::ctor: invalid format '{}'",
+                                format));
+  fRfc5424 = format == "rfc5424";
+
+  string facility = fOptions.String("facility", "local1");
+  auto itfac = find_if(begin(kFacilities), end(kFacilities),
+                       [&facility](auto& p) { return facility == p.first; });
+  if (itfac == end(kFacilities))
+    throw Exception(fmt::format("LoggerSinkDevlog::ctor: invalid facility '{}'",
+                                facility));
+  fFacility = itfac->second;
+
+  fIdent = fOptions.String("ident", "cbm");
+  fRetry = fOptions.Double("retry", 1.);
+
+  // setup Logger -> syslog severity mapping, kept as `<PRI>` strings
+  int sevmap[Logger::kLogFatal + 1] = {};
+  sevmap[Logger::kLogTrace] = LOG_DEBUG;
+  sevmap[Logger::kLogDebug] = LOG_DEBUG;
+  sevmap[Logger::kLogInfo] = LOG_INFO;
+  sevmap[Logger::kLogNote] = LOG_NOTICE;
+  sevmap[Logger::kLogWarning] = LOG_WARNING;
+  sevmap[Logger::kLogError] = LOG_ERR;
+  sevmap[Logger::kLogFatal] = LOG_ERR; // EMERG is too noisy !
+  for (int sev : sevmap)
+    fPriMap.push_back(
+        fmt::format("<{}>{}", fFacility | sev, fRfc5424 ? "1 " : ""));
+
+  // the part of the header behind the timestamp is fixed
+  if (fRfc5424) {
+    fTag = fmt::format(" {} {} {} - - ", fLogger.HostName(), fIdent,
+                       ::getpid());
+  } else {
+    fTag = fmt::format("{}[{}]: ", fIdent, ::getpid());
+  }
+
+  // send timeout, applied to each socket created by Connect()
+  double timeout = fOptions.Double("timeout", kTimeout);
+  fTimeout.tv_sec = time_t(timeout);
+  fTimeout.tv_usec = suseconds_t((timeout - double(fTimeout.tv_sec)) * 1.e6);
+
+  (void)Connect();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of messages
+
+  All messages are formatted into one buffer, then sent with
+  SendDatagrams().
+ */
+
+void LoggerSinkDevlog::ProcessMessageVec(const vector<LoggerMessage>& msgvec) {
+  for (auto& msg : msgvec) {
+    if (msg.fSevId < fLogLevel)
+      continue;
+    size_t offset = fBuffer.size();
+    AppendHeader(msg);
+    fBuffer += "{time=";
+    AppendTimePoint(fBuffer, msg.fTime);
+    fBuffer += ",thread=";
+    fBuffer += msg.fThreadName;
+    fBuffer += ",sev=";
+    fBuffer += fLogger.SeverityCode2Text(msg.fSevId);
+    if (msg.fKeysSize) {
+      fBuffer += ',';
+      fBuffer += msg.Keys();
+    }
+    fBuffer += "}: ";
+    fBuffer += msg.Message();
+    fDatagrams.emplace_back(offset, fBuffer.size() - offset);
+  }
+  SendDatagrams();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Append the syslog header of a message to the buffer
+
+  The timestamp, in local time, is determined with `localtime_r(3)` and
+  cached, it is only recomputed when the second changes. For RFC 5424 only
+  the time zone offset is cached, the date/time is generated with
+  AppendTimePoint().
+ */
+
+void LoggerSinkDevlog::AppendHeader(const LoggerMessage& msg) {
+  int sevid = msg.fSevId;
+  if (sevid < 0 || sevid > Logger::kLogFatal)
+    sevid = Logger::kLogError;
+  fBuffer += fPriMap[size_t(sevid)];
+
+  auto sec = chrono::floor<chrono::seconds>(msg.fTime.time_since_epoch());
+  if (sec.count() != fStampSec) {
+    time_t tt = time_t(sec.count());
+    tm ltm = {};
+    (void)::localtime_r(&tt, &ltm);
+    fStamp.clear();
+    if (fRfc5424) {
+      long off = ltm.tm_gmtoff / 60;
+      fmt::format_to(back_inserter(fStamp), "{}{:02d}:{:02d}",
+                     off < 0 ? '-' : '+', labs(off) / 60, labs(off) % 60);
+    } else {
+      fmt::format_to(back_inserter(fStamp), "{} {:2d} {:02d}:{:02d}:{:02d} ",
+                     kMonths[ltm.tm_mon], ltm.tm_mday, ltm.tm_hour,
+                     ltm.tm_min, ltm.tm_sec);
+    }
+    fStampSec = sec.count();
+  }
+
+  if (fRfc5424)
+    AppendTimePoint(fBuffer, msg.fTime);
+  fBuffer += fStamp;
+  fBuffer += fTag;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Send all pending datagrams
+
+  Datagrams are sent in batches with `sendmmsg(2)`. When the syslog socket
+  was re-created a reconnect is tried once, when it fails or the send
+  timeout expires the remaining datagrams are dropped. Other send errors,
+  e.g. for a too large datagram, only drop the affected datagram.
+ */
+
+void LoggerSinkDevlog::SendDatagrams() {
+  size_t ndgram = fDatagrams.size();
+  if (ndgram == 0)
+    return;
+
+  vector<iovec> iovs(ndgram);
+  vector<mmsghdr> msgs(ndgram);
+  for (size_t i = 0; i < ndgram; i++) {
+    iovs[i].iov_base = fBuffer.data() + fDatagrams[i].first;
+    iovs[i].iov_len = fDatagrams[i].second;
+    msgs[i].msg_hdr = msghdr{};
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  bool reconnected = false;
+  size_t idgram = 0;
+  while (idgram < ndgram) {
+    if (fSockFd < 0 && !Connect()) {
+      Drop(ndgram - idgram, ENOTCONN);
+      break;
+    }
+    unsigned nbatch = unsigned(min(kSendBatch, ndgram - idgram));
+    int nsent = ::sendmmsg(fSockFd, &msgs[idgram], nbatch, 0);
+    if (nsent > 0) {
+      idgram += size_t(nsent);
+      continue;
+    }
+    int eno = nsent < 0 ? errno : 0;
+    if (eno == EINTR)
+      continue;
+    if (eno == ECONNREFUSED || eno == ENOTCONN || eno == ENOENT ||
+        eno == EPIPE) {
+      // the syslog daemon was restarted, reconnect once without delay
+      fSockFd.Close();
+      if (!reconnected) {
+        reconnected = true;
+        fNextConnect = sctime_point{};
+      }
+      continue;
+    }
+    if (eno == EAGAIN || eno == EWOULDBLOCK) { // send timeout expired
+      Drop(ndgram - idgram, eno);
+      break;
+    }
+    Drop(1, eno);
+    idgram += 1;
+  }
+
+  fBuffer.clear();
+  fDatagrams.clear();
+
+  if (fNDrop > 0 && fSockFd >= 0) {
+    std::cerr << "LoggerSinkDevlog::SendDatagrams error: "
+              << "sinkname=" << fSinkPath << ", dropped " << fNDrop
+              << " messages, error=" << ::strerror(fDropErrno) << "\n";
+    fNDrop = 0;
+    fDropErrno = 0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Connect to the syslog socket
+  \returns `true` if connected
+
+  A connect is only attempted when the `retry` period since the last
+  attempt has passed. A failure to create the socket, e.g. on `EMFILE`, is
+  handled like a failed connect. The first failure after a successful
+  connect is reported, later ones are silent.
+ */
+
+bool LoggerSinkDevlog::Connect() {
+  auto now = ScNow();
+  if (now < fNextConnect)
+    return false;
+  fNextConnect =
+      now + chrono::duration_cast<scduration>(chrono::duration<double>(fRetry));
+
+  const char* what = "socket";
+  int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd >= 0) {
+    fSockFd.Set(fd);
+    (void)::setsockopt(fSockFd, SOL_SOCKET, SO_SNDTIMEO, &fTimeout,
+                       sizeof(fTimeout));
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    fSockPath.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    what = "connect";
+    if (::connect(fSockFd, reinterpret_cast<sockaddr*>(&addr),
+                  sizeof(addr)) == 0) {
+      fConnLogged = false;
+      return true;
+    }
+  }
+
+  int eno = errno;
+  fSockFd.Close();
+  if (!fConnLogged) {
+    fConnLogged = true;
+    std::cerr << "LoggerSinkDevlog::Connect error: "
+              << "sinkname=" << fSinkPath << ", " << what
+              << " error=" << ::strerror(eno) << "\n";
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Count dropped datagrams
+  \param ndgram  number of dropped datagrams
+  \param eno     errno of the failed send, kept for the first drop
+ */
+
+void LoggerSinkDevlog::Drop(size_t ndgram, int eno) {
+  if (fNDrop == 0)
+    fDropErrno = eno;
+  fNDrop += ndgram;
+}
+
+} // end namespace cbm
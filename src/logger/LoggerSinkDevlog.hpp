@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_LoggerSinkDevlog
+#define included_Cbm_LoggerSinkDevlog 1
+
+#include "ChronoDefs.hpp"
+#include "FileDescriptor.hpp"
+#include "LoggerSink.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <sys/time.h>
+
+namespace cbm {
+using namespace std;
+
+class LoggerSinkDevlog : public LoggerSink {
+public:
+  LoggerSinkDevlog(Logger& logger, const string& path, int lvl);
+
+  virtual void ProcessMessageVec(const vector<LoggerMessage>& msgvec);
+
+private:
+  void AppendHeader(const LoggerMessage& msg);
+  void SendDatagrams();
+  bool Connect();
+  void Drop(size_t ndgram, int eno);
+
+private:
+  string fSockPath{};                        //!< path of syslog socket
+  bool fRfc5424{false};                      //!< use RFC 5424 format
+  int fFacility{0};                          //!< syslog facility code
+  string fIdent{};                           //!< syslog APP-NAME/TAG
+  double fRetry{1.};                         //!< reconnect period in sec
+  timeval fTimeout{};                        //!< send timeout
+  vector<string> fPriMap{};                  //!< `<PRI>` per severity
+  string fTag{};                             //!< header part after timestamp
+  FileDescriptor fSockFd{};                  //!< connected socket
+  sctime_point fNextConnect{};               //!< earliest next connect
+  bool fConnLogged{false};                   //!< connect error reported
+  int64_t fStampSec{INT64_MIN};              //!< second of fStamp
+  string fStamp{};                           //!< cached timestamp part
+  string fBuffer{};                          //!< buffer with all datagrams
+  vector<pair<size_t, size_t>> fDatagrams{}; //!< offset/size in fBuffer
+  uint64_t fNDrop{0};                        //!< # of unreported drops
+  int fDropErrno{0};                         //!< errno of first drop
+};
+
+} // end namespace cbm
+
+//#include "LoggerSinkDevlog.ipp"
+
+#endif
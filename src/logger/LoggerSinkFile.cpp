@@ -7,13 +7,14 @@
 #include "ChronoHelper.hpp"
 #include "Exception.hpp"
 #include "Logger.hpp"
+#include "SysCallException.hpp"
 
-#include "fmt/format.h"
-
-#include <fstream>
+#include <iostream>
 
 namespace cbm {
 using namespace std;
+// some constants
+static const size_t kBufSize = 1000000; // default write buffer size
 
 /*! \class LoggerSinkFile
   \brief Logger sink - concrete sink for file output
@@ -26,7 +27,15 @@ using namespace std;
   \param lvl    \glos{loglevel} for writing
 
   Write messages to a file named `path`. The special names `cout` and `cerr`
-  will open these standard streams, in all other cases a file will be opened.
+  will write to these standard streams, in all other cases a file will be
+  opened. The messages are buffered and written after each batch, see
+  FileWriter.
+
+  The file name can be followed by `?` and these options
+  - `bufsize`: size of the write buffer in bytes (default '1M')
+  - `io`, `iodepth`: output backend, see FileWriter::Configure()
+  - `rotsize`, `rotint`, `keep`, `compress`: file rotation, see
+    FileWriter::Configure()
 
   Several LoggerSinkFile sinks can be opened simultaneously and operated
   with different \glos{loglevel} settings.
@@ -34,16 +43,12 @@ using namespace std;
 
 LoggerSinkFile::LoggerSinkFile(Logger& logger, const string& path, int lvl)
     : LoggerSink(logger, path, lvl) {
-  if (path == "cout"s) {
-    fpCout = &cout;
-  } else if (path == "cerr"s) {
-    fpCout = &cerr;
-  } else {
-    fpOStream = make_unique<ofstream>(path);
-    if (!fpOStream->is_open())
-      throw Exception(
-          fmt::format("LoggerSinkFile::ctor: open() failed for '{}'", path));
-  }
+  vector<string> keys = FileWriter::kOptionKeys;
+  keys.push_back("bufsize");
+  fOptions.Check("LoggerSinkFile::ctor", keys);
+  fpWriter = make_unique<FileWriter>(fOptions.Path(),
+                                     fOptions.Size("bufsize", kBufSize));
+  fpWriter->Configure(fOptions);
 }
 
 //-----------------------------------------------------------------------------
@@ -51,23 +56,38 @@ LoggerSinkFile::LoggerSinkFile(Logger& logger, const string& path, int lvl)
  */
 
 void LoggerSinkFile::ProcessMessageVec(const vector<LoggerMessage>& msgvec) {
-  ostream& os = fpCout ? *fpCout : *fpOStream;
   size_t msgcnt = 0;
 
-  for (auto& msg : msgvec) {
-    if (msg.fSevId < fLogLevel)
-      continue;
-    msgcnt += 1;
-    string keys =
-        fmt::format("host={},thread={},sev={}", fLogger.HostName(),
-                    msg.fThreadName, fLogger.SeverityCode2Text(msg.fSevId));
-    if (msg.fKeys.length())
-      keys += "," + msg.fKeys;
-    os << TimePoint2String(msg.fTime) << ": {" << keys << "}: " << msg.fMessage
-       << "\n";
+  try {
+    for (auto& msg : msgvec) {
+      if (msg.fSevId < fLogLevel)
+        continue;
+      msgcnt += 1;
+      // assemble in a reused buffer, avoids allocations in a message burst
+      fLine.clear();
+      AppendTimePoint(fLine, msg.fTime);
+      fLine += ": {host=";
+      fLine += fLogger.HostName();
+      fLine += ",thread=";
+      fLine += msg.fThreadName;
+      fLine += ",sev=";
+      fLine += fLogger.SeverityCode2Text(msg.fSevId);
+      if (msg.fKeysSize) {
+        fLine += ',';
+        fLine += msg.Keys();
+      }
+      fLine += "}: ";
+      fLine += msg.Message();
+      fLine += '\n';
+      fpWriter->Write(fLine);
+    }
+    if (msgcnt > 0)
+      fpWriter->Flush();
+  } catch (const SysCallException& e) {
+    // can't log via the Logger from within a sink
+    std::cerr << "LoggerSinkFile::ProcessMessageVec error: "
+              << "sinkname=" << fSinkPath << ", error=" << e.what() << "\n";
   }
-  if (msgcnt > 0)
-    os.flush();
 }
 
 } // end namespace cbm
@@ -5,10 +5,9 @@
 #ifndef included_Cbm_LoggerSinkFile
 #define included_Cbm_LoggerSinkFile 1
 
+#include "FileWriter.hpp"
 #include "LoggerSink.hpp"
 
-#include <fstream>
-#include <iostream>
 #include <memory>
 
 namespace cbm {
@@ -21,8 +20,8 @@ public:
   virtual void ProcessMessageVec(const vector<LoggerMessage>& msgvec);
 
 private:
-  ostream* fpCout{nullptr};         //!< pointer to cout/cerr
-  unique_ptr<ofstream> fpOStream{}; //!< uptr to general output stream
+  unique_ptr<FileWriter> fpWriter{}; //!< buffered file writer
+  string fLine{};                    //!< line buffer, reused
 };
 
 } // end namespace cbm
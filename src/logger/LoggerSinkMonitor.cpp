@@ -10,32 +10,91 @@
 #include "Metric.hpp"
 #include "Monitor.hpp"
 
+#include "fmt/format.h"
+
 namespace cbm {
 using namespace std;
 
 /*! \class LoggerSinkMonitor
-  \brief Logger sink - concrete sink for file output
+  \brief Logger sink - concrete sink for Monitor output
+
+  Forwards Logger messages to the Monitor, either each message as a Metric
+  (detailed mode) or as message counts aggregated over an interval
+  (aggregated mode), see the constructor.
+
+  Messages with `cid=__Monitor` and a severity of Warning or above are
+  dropped in both modes. They will be related to MonitorSink processing,
+  will likely not be delivered anyway, and might create an eternal
+  Logger/Monitor loop.
 */
 
 //-----------------------------------------------------------------------------
 /*! \brief Constructor
   \param logger back reference to Logger
-  \param path   filename (ignored)
+  \param path   options, see below
   \param lvl    \glos{loglevel} for writing
+  \throws Exception in case of invalid options
 
-  Write messages to Monitor. The Metric tag set it contains
+  The path is ignored, it can be followed by `?` and these options
+  - `mode`: `detail` (default) or `aggregate`
+  - `interval`: interval of aggregated mode in sec (default 10.)
+  - `sample`: when `true` the aggregated mode adds the first message of an
+    interval (default `false`)
+
+  In detailed mode each message is written as a Metric to measurement
+  "Logger". The Metric tag set contains
   - thread (from message)
   - severity (numeric, from message)
   - all other keys from the message key list
 
   The Metric field set contains a single field named 'msg' with the message
-  body.
+  body. This is fine for low message rates, but floods the Monitor
+  back-end during a message storm.
+
+  In aggregated mode the messages are only counted per severity and the
+  values of the keys `cid` and `mid`. At the end of each interval each
+  series with messages is written as a Metric to measurement "LoggerRate"
+  with the tags
+  - sev (numeric)
+  - cid and mid (omitted when empty)
+
+  and the fields
+  - count: number of messages in the interval
+  - rate: messages per second in the interval
+  - msg: first message body in the interval, only with option `sample`
+
+  A series which had no message in an interval is written once with a
+  count of zero and then forgotten.
  */
 
 LoggerSinkMonitor::LoggerSinkMonitor(Logger& logger,
                                      const string& path,
                                      int lvl)
-    : LoggerSink(logger, path, lvl) {}
+    : LoggerSink(logger, path, lvl) {
+  fOptions.Check("LoggerSinkMonitor::ctor", {"mode", "interval", "sample"});
+  string mode = fOptions.String("mode", "detail");
+  if (mode != "detail" && mode != "aggregate")
+    throw Exception(
+        fmt::format("LoggerSinkMonitor::ctor: invalid mode '{}'", mode));
+  fAggregate = mode == "aggregate";
+  double interval = fOptions.Double("interval", 10.);
+  if (interval <= 0.)
+    throw Exception(
+        fmt::format("LoggerSinkMonitor::ctor: invalid interval {}", interval));
+  fInterval =
+      chrono::duration_cast<scduration>(chrono::duration<double>(interval));
+  fSample = fOptions.Bool("sample", false);
+  fLastSend = ScNow();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor, sends the counts of the last, partial, interval
+ */
+
+LoggerSinkMonitor::~LoggerSinkMonitor() {
+  if (fAggregate)
+    SendCounters(ScNow());
+}
 
 //-----------------------------------------------------------------------------
 /*! \brief Process a vector of messages
@@ -45,33 +104,112 @@ void LoggerSinkMonitor::ProcessMessageVec(const vector<LoggerMessage>& msgvec) {
   for (auto& msg : msgvec) {
     if (msg.fSevId < fLogLevel)
       continue;
-    MetricTagSet tagset = {{"thread", msg.fThreadName},
-                           {"sev", to_string(msg.fSevId)}};
-    size_t pbeg = 0;
-    size_t pend = 0;
-    bool cidmoni = false;
-    while ((pbeg = msg.fKeys.find_first_not_of(',', pend)) != string::npos) {
-      pend = msg.fKeys.find(',', pbeg);
-      string keyval = msg.fKeys.substr(pbeg, pend - pbeg);
-      size_t pdel = keyval.find('=');
-      if (keyval == "cid=__Monitor")
-        cidmoni = true;
-      if (pdel != string::npos && pdel > 0 && pdel + 1 < keyval.size())
-        tagset.emplace_back(keyval.substr(0, pdel), keyval.substr(pdel + 1));
+    if (msg.fSevId >= Logger::kLogWarning && msg.Key("cid") == "__Monitor")
+      continue;
+    if (fAggregate) {
+      Count(msg);
+    } else {
+      SendDetailed(msg);
     }
+  }
+}
 
-    // drop messages related to Monitor with a severity of Warning or above.
-    // They will be related to MonitorSink processing, will lileky not be
-    // delivered anyway, and might create an eternal Logger/Monitor loop
-    if (cidmoni && msg.fSevId >= Logger::kLogWarning)
-      continue;
+//-----------------------------------------------------------------------------
+/*! \brief Sends the counters when the interval expired (aggregated mode)
+ */
+
+void LoggerSinkMonitor::ProcessHeartbeat() {
+  if (!fAggregate)
+    return;
+  auto now = ScNow();
+  if (now - fLastSend >= fInterval)
+    SendCounters(now);
+}
 
-    // ensure that Monitor is running, it is started after Logger and stopped
-    // before Logger. A very early or very late Logger messages are therefore
-    // not transfered to Monitor.
-    if (Monitor::Ptr())
-      Monitor::Ptr()->QueueMetric("Logger", move(tagset),
-                                  {{"msg", msg.fMessage}}, msg.fTime);
+//-----------------------------------------------------------------------------
+/*! \brief Sends a message as Metric (detailed mode)
+ */
+
+void LoggerSinkMonitor::SendDetailed(const LoggerMessage& msg) {
+  // the tags are taken from the key set index, only empty values are
+  // skipped
+  MetricTagSet tagset;
+  tagset.reserve(msg.NKeys() + 2);
+  tagset.emplace_back("thread", msg.fThreadName);
+  tagset.emplace_back("sev", to_string(msg.fSevId));
+  for (size_t i = 0; i < msg.NKeys(); i++) {
+    string_view val = msg.KeyValue(i);
+    if (!val.empty())
+      tagset.emplace_back(msg.KeyName(i), val);
+  }
+
+  // ensure that Monitor is running, it is started after Logger and stopped
+  // before Logger. A very early or very late Logger messages are therefore
+  // not transfered to Monitor.
+  if (Monitor::Ptr())
+    Monitor::Ptr()->QueueMetric("Logger", move(tagset),
+                                {{"msg", string(msg.Message())}}, msg.fTime);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Counts a message (aggregated mode)
+
+  The lookup key is assembled in a reused buffer, so only the first message
+  of a series allocates.
+ */
+
+void LoggerSinkMonitor::Count(const LoggerMessage& msg) {
+  string_view cid = msg.Key("cid");
+  string_view mid = msg.Key("mid");
+  fKey.clear();
+  fKey += char('0' + msg.fSevId);
+  fKey += cid;
+  fKey += '\0';
+  fKey += mid;
+
+  auto it = fCounters.find(fKey);
+  if (it == fCounters.end())
+    it = fCounters
+             .try_emplace(fKey, Counter{msg.fSevId, string(cid), string(mid)})
+             .first;
+  Counter& cnt = it->second;
+  if (cnt.fCount == 0 && fSample)
+    cnt.fSample = msg.Message();
+  cnt.fCount += 1;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Sends the counters as Metric and starts a new interval
+  \param now    end time of the interval
+ */
+
+void LoggerSinkMonitor::SendCounters(const sctime_point& now) {
+  double dt = ScTimeDiff2Double(fLastSend, now);
+  fLastSend = now;
+  Monitor* pmon = Monitor::Ptr();
+
+  for (auto it = fCounters.begin(); it != fCounters.end();) {
+    Counter& cnt = it->second;
+    if (pmon) {
+      MetricTagSet tagset = {{"sev", to_string(cnt.fSevId)}};
+      if (!cnt.fCid.empty())
+        tagset.emplace_back("cid", cnt.fCid);
+      if (!cnt.fMid.empty())
+        tagset.emplace_back("mid", cnt.fMid);
+      MetricFieldSet fieldset = {
+          {"count", cnt.fCount},
+          {"rate", dt > 0. ? double(cnt.fCount) / dt : 0.}};
+      if (fSample && cnt.fCount > 0)
+        fieldset.emplace_back("msg", move(cnt.fSample));
+      pmon->QueueMetric("LoggerRate", move(tagset), move(fieldset), now);
+    }
+    if (cnt.fCount == 0) { // idle for a whole interval, forget series
+      it = fCounters.erase(it);
+    } else {
+      cnt.fCount = 0;
+      cnt.fSample.clear();
+      ++it;
+    }
   }
 }
 
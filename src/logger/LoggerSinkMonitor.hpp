@@ -5,18 +5,42 @@
 #ifndef included_Cbm_LoggerSinkMonitor
 #define included_Cbm_LoggerSinkMonitor 1
 
+#include "ChronoDefs.hpp"
 #include "LoggerSink.hpp"
 
+#include <unordered_map>
+
 namespace cbm {
 using namespace std;
 
 class LoggerSinkMonitor : public LoggerSink {
 public:
   LoggerSinkMonitor(Logger& logger, const string& path, int lvl);
+  virtual ~LoggerSinkMonitor();
 
   virtual void ProcessMessageVec(const vector<LoggerMessage>& msgvec);
+  virtual void ProcessHeartbeat();
+
+private:
+  struct Counter {
+    int fSevId{0};    //!< severity
+    string fCid{};    //!< value of key `cid`
+    string fMid{};    //!< value of key `mid`
+    long fCount{0};   //!< # of messages in current interval
+    string fSample{}; //!< first message body in current interval
+  };
+
+  void SendDetailed(const LoggerMessage& msg);
+  void Count(const LoggerMessage& msg);
+  void SendCounters(const sctime_point& now);
 
 private:
+  bool fAggregate{false};                     //!< aggregated mode
+  bool fSample{false};                        //!< send a sample message
+  scduration fInterval{};                     //!< interval in aggregated mode
+  sctime_point fLastSend{};                   //!< time of last SendCounters()
+  string fKey{};                              //!< lookup key, reused
+  unordered_map<string, Counter> fCounters{}; //!< counters per series
 };
 
 } // end namespace cbm
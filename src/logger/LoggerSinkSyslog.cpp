@@ -67,14 +67,16 @@ void LoggerSinkSyslog::ProcessMessageVec(const vector<LoggerMessage>& msgvec) {
     string keys =
         fmt::format("time={},thread={},sev={}", TimePoint2String(msg.fTime),
                     msg.fThreadName, fLogger.SeverityCode2Text(msg.fSevId));
-    if (msg.fKeys.length())
-      keys += "," + msg.fKeys;
+    if (msg.fKeysSize)
+      keys += ","s.append(msg.Keys());
 
     int syslvl = LOG_ERR;
     if (msg.fSevId >= 0 && msg.fSevId <= Logger::kLogFatal)
       syslvl = fSevMap[size_t(msg.fSevId)];
 
-    ::syslog(syslvl, "{%s}: %s", keys.c_str(), msg.fMessage.c_str());
+    string_view text = msg.Message();
+    ::syslog(syslvl, "{%s}: %.*s", keys.c_str(), int(text.size()),
+             text.data());
   }
 }
 
@@ -12,11 +12,25 @@
 namespace cbm {
 
 /*! \class LoggerStream
-  \brief Provides an `ostream` interface to which a message can be written
+  \brief Provides a stream interface to which a message can be written
 
   The constructor will setup a message context with timestamp, severity and
   key set. The message body will be added via `Stream()` and `operator<<()`.
   The dectructor will finally queue the message to the Logger core.
+
+  Key set and message body are written into a per-thread buffer which is
+  reused from message to message, so its capacity is allocated only once.
+  Strings and numbers are formatted directly into that buffer with `fmt`,
+  other types via an `ostream` which appends to the same buffer. The only
+  allocation per message is the copy of the buffer which is handed to the
+  Logger core in the destructor. The node of the message queue is recycled,
+  see MpscQueue, and the key set index needs no allocation for up to
+  LoggerMessage::kNKeyInline keys. A message created while another message
+  of the same thread is still open, e.g. when a value written to a message
+  is itself logging, uses a private buffer instead.
+
+  A message suppressed by the Logger rate limit, see Logger::SetRateLimit(),
+  ignores all values written to it and is not queued.
  */
 
 //-----------------------------------------------------------------------------
@@ -38,29 +52,94 @@ LoggerStream::LoggerStream(Logger& logger,
                            const string& keys1,
                            const string& mid,
                            const string& keys2)
-    : fLogger(logger), fTime(ScNow()), fSevId(sev), fThreadName(PThreadName()),
-      fKeys(keys1), fSStream() {
-  if (mid.length())
-    fKeys += ",mid=" + mid;
+    : fLogger(logger), fTime(), fSevId(sev) {
+  fpBuffer = &ThreadBuffer();
+  if (fpBuffer->fInUse) {
+    fOwnBuffer = make_unique<Buffer>();
+    fpBuffer = fOwnBuffer.get();
+  }
+  fpBuffer->fInUse = true;
+  if (fpBuffer->fOStreamUsed) { // restore default ostream state
+    ostream& ostr = fpBuffer->fOStream;
+    ostr.clear();
+    ostr.flags(ios_base::dec | ios_base::skipws);
+    ostr.precision(6);
+    ostr.width(0);
+    ostr.fill(' ');
+    fpBuffer->fOStreamUsed = false;
+  }
+
+  string& text = fpBuffer->fText;
+  text.clear();
+  if (!fLogger.RateAdmit(sev, keys1, mid, keys2)) {
+    fSuppressed = true;
+    return;
+  }
+  fTime = ScNow();
+  text.append(keys1);
+  if (mid.length()) {
+    text.append(",mid=");
+    text.append(mid);
+  }
   if (keys2.length()) {
     string_view keys2sv(keys2); // view with dropped trailing ','
     if (keys2sv[keys2sv.length() - 1] == ',')
       keys2sv.remove_suffix(1);
-    fKeys += ",";
-    fKeys += keys2sv;
+    text.push_back(',');
+    text.append(keys2sv);
   }
+  fKeysSize = text.size();
 }
 
 //-----------------------------------------------------------------------------
 /*! \brief Destructor
 
-  Queues the message for processing by the Logger core.
+  Records the message in the flight recorder, when one is open, and queues
+  it for processing by the Logger core, unless it was suppressed by the
+  Logger rate limit or only the flight recorder takes it.
  */
 
 LoggerStream::~LoggerStream() {
-  string text = fSStream.str();
+  fpBuffer->fInUse = false;
+  if (fSuppressed)
+    return;
+  LoggerRecorder* prec = fLogger.Recorder();
+  if (prec && fSevId >= fLogger.RecorderLogLevel())
+    prec->Record(fTime, fSevId, PThreadName(), fpBuffer->fText, fKeysSize);
+  if (fSevId < fLogger.MinQueueLogLevel()) // only for the flight recorder
+    return;
+  string text(fpBuffer->fText);
   fLogger.QueueMessage(
-      LoggerMessage{fTime, fSevId, move(fThreadName), move(fKeys), move(text)});
+      LoggerMessage{fTime, fSevId, PThreadName(), move(text), fKeysSize});
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the buffer of the calling thread
+ */
+
+LoggerStream::Buffer& LoggerStream::ThreadBuffer() {
+  static thread_local Buffer buffer;
+  return buffer;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Append a character to the target string
+ */
+
+LoggerStream::StringBuf::int_type
+LoggerStream::StringBuf::overflow(int_type c) {
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+    fStr.push_back(traits_type::to_char_type(c));
+  return traits_type::not_eof(c);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Append `n` characters to the target string
+ */
+
+streamsize LoggerStream::StringBuf::xsputn(const char* str, streamsize n) {
+  fStr.append(str, size_t(n));
+  return n;
 }
 
 } // end namespace cbm
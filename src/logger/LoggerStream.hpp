@@ -7,7 +7,10 @@
 
 #include "ChronoDefs.hpp"
 
-#include <sstream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
 
 namespace cbm {
 
@@ -23,15 +26,49 @@ public:
                const string& keys2);
   ~LoggerStream();
 
-  ostream& Stream();
+  LoggerStream(const LoggerStream&) = delete;
+  LoggerStream& operator=(const LoggerStream&) = delete;
+
+  LoggerStream& Stream();
+  ostream& OStream();
+
+  template <typename T> LoggerStream& operator<<(const T& val);
+  LoggerStream& operator<<(ostream& (*manip)(ostream&));
+  LoggerStream& operator<<(ios_base& (*manip)(ios_base&));
+
+private:
+  class StringBuf : public streambuf {
+  public:
+    explicit StringBuf(string& str) : fStr(str) {}
+
+  protected:
+    virtual int_type overflow(int_type c);
+    virtual streamsize xsputn(const char* str, streamsize n);
+
+  private:
+    string& fStr; //!< target string
+  };
+
+  struct Buffer {
+    Buffer() : fSBuf(fText), fOStream(&fSBuf) {}
+    string fText{};           //!< key set followed by message body
+    StringBuf fSBuf;          //!< streambuf appending to fText
+    ostream fOStream;         //!< ostream writing to fText
+    bool fInUse{false};       //!< held by a LoggerStream
+    bool fOStreamUsed{false}; //!< fOStream state might be modified
+  };
+
+  static Buffer& ThreadBuffer();
 
 private:
-  Logger& fLogger;        //!< back reference to Logger
-  sctime_point fTime;     //!< timestamo
-  int fSevId;             //!< severity
-  string fThreadName;     //!< thread name
-  string fKeys;           //!< key string
-  ostringstream fSStream; //!< message
+  Logger& fLogger;               //!< back reference to Logger
+  sctime_point fTime;            //!< timestamp
+  int fSevId;                    //!< severity
+  size_t fKeysSize{0};           //!< length of key set in buffer
+  unique_ptr<Buffer> fOwnBuffer; //!< private buffer for nested messages
+  Buffer* fpBuffer{nullptr};     //!< buffer holding key set and message
+  bool fOStreamMode{false};      //!< route all values via ostream
+  bool fSuppressed{false};       //!< dropped by rate limit
 };
 
 } // end namespace cbm
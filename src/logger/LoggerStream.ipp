@@ -2,14 +2,85 @@
 // (C) Copyright 2020 GSI Helmholtzzentrum für Schwerionenforschung
 // Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
 
+#include "fmt/format.h"
+
+#include <string_view>
+#include <type_traits>
+
 namespace cbm {
 
 //-----------------------------------------------------------------------------
-/*! \brief Returns reference of `ostream` embedded in LoggerStream
+/*! \brief Returns reference of LoggerStream itself
 
   Used in conjuction with `operator<<()` to write the message body.
  */
 
-inline ostream& LoggerStream::Stream() { return fSStream; }
+inline LoggerStream& LoggerStream::Stream() { return *this; }
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns reference of `ostream` writing into the message body
+
+  Values written directly to this `ostream` and values written with
+  `operator<<()` can be mixed freely.
+ */
+
+inline ostream& LoggerStream::OStream() {
+  fOStreamMode = true;
+  fpBuffer->fOStreamUsed = true;
+  return fpBuffer->fOStream;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Append a value to the message body
+
+  Characters, strings, and integral and floating point numbers are directly
+  formatted into the buffer, with the same result as the default formatting
+  of an `ostream`. All other types are written via the `ostream`, and
+  because they might change its state, so are all subsequent values.
+ */
+
+template <typename T>
+inline LoggerStream& LoggerStream::operator<<(const T& val) {
+  using vtype = decay_t<T>;
+  if (fSuppressed)
+    return *this;
+  string& text = fpBuffer->fText;
+  if (fOStreamMode) {
+    fpBuffer->fOStream << val;
+  } else if constexpr (is_same_v<vtype, char>) {
+    text.push_back(val);
+  } else if constexpr (is_pointer_v<T> &&
+                       is_same_v<remove_cv_t<remove_pointer_t<T>>, char>) {
+    if (val)
+      text.append(val);
+  } else if constexpr (is_convertible_v<const T&, string_view>) {
+    text.append(string_view(val));
+  } else if constexpr (is_integral_v<vtype> && !is_same_v<vtype, bool> &&
+                       sizeof(vtype) > 1) {
+    fmt::format_int fval(val);
+    text.append(fval.data(), fval.size());
+  } else if constexpr (is_floating_point_v<vtype>) {
+    fmt::format_to(back_inserter(text), "{:g}", val);
+  } else {
+    OStream() << val;
+  }
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Apply an `ostream` manipulator, like `endl` or `flush`
+
+inline LoggerStream& LoggerStream::operator<<(ostream& (*manip)(ostream&)) {
+  OStream() << manip;
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Apply an `ios_base` manipulator, like `hex` or `fixed`
+
+inline LoggerStream& LoggerStream::operator<<(ios_base& (*manip)(ios_base&)) {
+  OStream() << manip;
+  return *this;
+}
 
 } // end namespace cbm
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MetricCodec.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+
+#include "fmt/format.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const uint8_t kCodecVersion = 1; // frame format version
+enum FieldType : uint8_t {
+  kFalse = 0,
+  kTrue,
+  kInt,
+  kLong,
+  kULong,
+  kDouble,
+  kString
+};
+
+/*! \file MetricCodec.cpp
+  \brief Compact binary encoding of Metric vectors
+
+  Used to transfer metrics between processes, e.g. from MonitorSinkAgent to
+  the `monitor_agent` daemon. A frame holds a batch of metrics:
+  - a version byte
+  - the number of metrics as varint
+  - for each metric: the measurement, the timestamp as zigzag varint of the
+    difference to the previous timestamp in ns, the number of tags, the tag
+    key and value strings, the number of fields, and for each field the key,
+    a type byte and the value
+
+  Integers are encoded as varints, signed ones zigzag mapped, doubles as
+  8 bytes in host byte order. Strings are dictionary encoded per frame: the
+  first occurrence is sent literally, later ones as index. Since metrics of
+  a batch repeat measurement, tag and field names the frames are much
+  smaller than the line format.
+ */
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// encoder helpers
+
+void PutVarint(string& out, uint64_t val) {
+  while (val >= 0x80) {
+    out += char(uint8_t(val) | 0x80);
+    val >>= 7;
+  }
+  out += char(uint8_t(val));
+}
+
+void PutZigzag(string& out, int64_t val) {
+  PutVarint(out, (uint64_t(val) << 1) ^ uint64_t(val >> 63));
+}
+
+struct Encoder {
+  string& fOut;
+  unordered_map<string, uint64_t> fDict{};
+
+  void PutString(const string& str) {
+    auto [it, isnew] = fDict.try_emplace(str, fDict.size());
+    if (!isnew) {
+      PutVarint(fOut, it->second << 1);
+      return;
+    }
+    PutVarint(fOut, (uint64_t(str.size()) << 1) | 1);
+    fOut += str;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// decoder helpers
+
+struct Decoder {
+  string_view fIn;
+  size_t fPos{0};
+  vector<string> fDict{};
+
+  [[noreturn]] void Fail(const char* what) {
+    throw Exception(
+        fmt::format("MetricDecode: {} at offset {} of {}", what, fPos,
+                    fIn.size()));
+  }
+
+  uint64_t GetVarint() {
+    uint64_t res = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (fPos >= fIn.size())
+        Fail("truncated varint");
+      uint8_t byte = uint8_t(fIn[fPos++]);
+      res |= uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return res;
+    }
+    Fail("invalid varint");
+  }
+
+  int64_t GetZigzag() {
+    uint64_t val = GetVarint();
+    return int64_t(val >> 1) ^ -int64_t(val & 1);
+  }
+
+  const string& GetString() {
+    uint64_t val = GetVarint();
+    if (!(val & 1)) {
+      if ((val >> 1) >= fDict.size())
+        Fail("invalid string reference");
+      return fDict[val >> 1];
+    }
+    uint64_t len = val >> 1;
+    if (len > fIn.size() - fPos)
+      Fail("truncated string");
+    fDict.emplace_back(fIn.substr(fPos, len));
+    fPos += len;
+    return fDict.back();
+  }
+};
+
+} // end anonymous namespace
+
+//-----------------------------------------------------------------------------
+/*! \brief Encode a range of metrics into a frame
+  \param metvec   vector of metrics
+  \param ibeg     index of first metric to encode
+  \param iend     index after last metric to encode
+  \param frame    the encoded frame is appended to this string
+ */
+
+void MetricEncode(const vector<Metric>& metvec,
+                  size_t ibeg,
+                  size_t iend,
+                  string& frame) {
+  Encoder enc{frame};
+  frame += char(kCodecVersion);
+  PutVarint(frame, iend - ibeg);
+  int64_t tlast = 0;
+  for (size_t i = ibeg; i < iend; i++) {
+    const Metric& met = metvec[i];
+    enc.PutString(met.fMeasurement);
+    int64_t tnow = ScTimePoint2Nsec(met.fTimestamp);
+    PutZigzag(frame, tnow - tlast);
+    tlast = tnow;
+    PutVarint(frame, met.fTagset.size());
+    for (auto& tag : met.fTagset) {
+      enc.PutString(tag.first);
+      enc.PutString(tag.second);
+    }
+    PutVarint(frame, met.fFieldset.size());
+    for (auto& field : met.fFieldset) {
+      enc.PutString(field.first);
+      auto& val = field.second;
+      if (auto pval = get_if<bool>(&val)) {
+        frame += char(*pval ? kTrue : kFalse);
+      } else if (auto pval = get_if<int>(&val)) {
+        frame += char(kInt);
+        PutZigzag(frame, *pval);
+      } else if (auto pval = get_if<long>(&val)) {
+        frame += char(kLong);
+        PutZigzag(frame, *pval);
+      } else if (auto pval = get_if<unsigned long>(&val)) {
+        frame += char(kULong);
+        PutVarint(frame, *pval);
+      } else if (auto pval = get_if<double>(&val)) {
+        frame += char(kDouble);
+        char buf[sizeof(double)];
+        memcpy(buf, pval, sizeof(double));
+        frame.append(buf, sizeof(double));
+      } else {
+        frame += char(kString);
+        enc.PutString(get<string>(val));
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Decode a frame
+  \param frame    encoded frame, as produced by MetricEncode()
+  \param metvec   the decoded metrics are appended to this vector
+  \throws Exception if the frame is malformed
+ */
+
+void MetricDecode(string_view frame, vector<Metric>& metvec) {
+  Decoder dec{frame};
+  if (frame.empty() || uint8_t(frame[0]) != kCodecVersion)
+    dec.Fail("unsupported version");
+  dec.fPos = 1;
+  uint64_t npoint = dec.GetVarint();
+  if (npoint > frame.size()) // each point needs at least a few bytes
+    dec.Fail("invalid point count");
+  metvec.reserve(metvec.size() + npoint);
+  int64_t tlast = 0;
+  for (uint64_t i = 0; i < npoint; i++) {
+    Metric met;
+    met.fMeasurement = dec.GetString();
+    tlast += dec.GetZigzag();
+    met.fTimestamp = Nsec2ScTimePoint(tlast);
+    uint64_t ntag = dec.GetVarint();
+    if (ntag > frame.size())
+      dec.Fail("invalid tag count");
+    met.fTagset.reserve(ntag);
+    for (uint64_t itag = 0; itag < ntag; itag++) {
+      string key = dec.GetString();
+      met.fTagset.emplace_back(move(key), dec.GetString());
+    }
+    uint64_t nfield = dec.GetVarint();
+    if (nfield > frame.size())
+      dec.Fail("invalid field count");
+    met.fFieldset.reserve(nfield);
+    for (uint64_t ifield = 0; ifield < nfield; ifield++) {
+      string key = dec.GetString();
+      if (dec.fPos >= frame.size())
+        dec.Fail("truncated field");
+      uint8_t type = uint8_t(frame[dec.fPos++]);
+      switch (type) {
+      case kFalse:
+      case kTrue:
+        met.fFieldset.emplace_back(move(key), type == kTrue);
+        break;
+      case kInt:
+        met.fFieldset.emplace_back(move(key), int(dec.GetZigzag()));
+        break;
+      case kLong:
+        met.fFieldset.emplace_back(move(key), long(dec.GetZigzag()));
+        break;
+      case kULong:
+        met.fFieldset.emplace_back(move(key),
+                                   (unsigned long)(dec.GetVarint()));
+        break;
+      case kDouble: {
+        if (frame.size() - dec.fPos < sizeof(double))
+          dec.Fail("truncated double");
+        double val = 0.;
+        memcpy(&val, frame.data() + dec.fPos, sizeof(double));
+        dec.fPos += sizeof(double);
+        met.fFieldset.emplace_back(move(key), val);
+        break;
+      }
+      case kString:
+        met.fFieldset.emplace_back(move(key), dec.GetString());
+        break;
+      default:
+        dec.Fail("invalid field type");
+      }
+    }
+    metvec.push_back(move(met));
+  }
+  if (dec.fPos != frame.size())
+    dec.Fail("trailing bytes");
+}
+
+} // end namespace cbm
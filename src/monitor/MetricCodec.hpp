@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MetricCodec
+#define included_Cbm_MetricCodec 1
+
+#include "Metric.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cbm {
+using namespace std;
+
+void MetricEncode(const vector<Metric>& metvec,
+                  size_t ibeg,
+                  size_t iend,
+                  string& frame);
+void MetricDecode(string_view frame, vector<Metric>& metvec);
+
+} // end namespace cbm
+
+//#include "MetricCodec.ipp"
+
+#endif
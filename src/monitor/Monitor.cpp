@@ -5,10 +5,18 @@
 #include "Monitor.hpp"
 
 #include "ChronoHelper.hpp"
+#include "CrashHandler.hpp"
 #include "Exception.hpp"
+#include "MonitorSinkAgent.hpp"
 #include "MonitorSinkFile.hpp"
 #include "MonitorSinkInflux1.hpp"
 #include "MonitorSinkInflux2.hpp"
+#include "MonitorSinkInfluxShard.hpp"
+#include "MonitorSinkProm.hpp"
+#include "MonitorSinkShm.hpp"
+#include "MonitorSinkStatsd.hpp"
+#include "MonitorSinkUdp.hpp"
+#include "MonitorSinkUnix.hpp"
 #include "PThreadHelper.hpp"
 #include "SysCallException.hpp"
 
@@ -18,6 +26,7 @@
 #include <poll.h>
 #include <sys/eventfd.h>
 #include <sys/timerfd.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace cbm {
@@ -61,10 +70,17 @@ using namespace std::chrono_literals;
   - OpenSink(): creates a new sink
   - CloseSink(): removes a sink
 
-  Currently two sink type is implemented
+  Currently these sink types are implemented
   - MonitorSinkFile: writes to files
   - MonitorSinkInflux1: writes to a InfluxDB V1.x time-series database
   - MonitorSinkInflux2: writes to a InfluxDB V2.x time-series database
+  - MonitorSinkInfluxShard: distributes series over several InfluxDBs
+  - MonitorSinkUdp: sends line format as UDP datagrams, e.g. to Telegraf
+  - MonitorSinkUnix: streams line format over a Unix socket to a local agent
+  - MonitorSinkProm: serves the latest values for Prometheus scrapes
+  - MonitorSinkStatsd: sends aggregated StatsD lines, e.g. to DogStatsD
+  - MonitorSinkShm: writes into a shared memory ring for a local reader
+  - MonitorSinkAgent: sends binary frames to the node-local monitor_agent
 
   The Monitor is a \glos{singleton} and accessed via the Monitor::Ref() static
   method.
@@ -79,12 +95,40 @@ using namespace std::chrono_literals;
     `mutex` is thus very unlikely:
     - at metrics queueing: just a `vector::push_back(move(...))`
     - at metrics processing: just a `vector::swap(...)`
+  - when a CrashHandler is installed the still queued metrics are written
+    on a fatal signal, see CrashHook().
 */
 
 //-----------------------------------------------------------------------------
 // some constants
 static constexpr scduration kHeartbeat = 60s; // heartbeat interval
 
+//-----------------------------------------------------------------------------
+// marks the metric queue as modified for the lifetime of the object, see
+// Monitor::CrashHook(); waits while the crash hook reads the queue
+class MetVecBusy {
+public:
+  MetVecBusy(atomic<bool>& busy, const atomic<bool>& park) : fBusy(busy) {
+    fBusy.store(true);
+    while (park.load()) {
+      fBusy.store(false);
+      this_thread::sleep_for(chrono::milliseconds(10));
+      fBusy.store(true);
+    }
+  }
+  ~MetVecBusy() { fBusy.store(false); }
+
+private:
+  atomic<bool>& fBusy;
+};
+
+// appends `str` to `buf` without ' ', '=' and ',', see MonitorSink
+static void AppendClean(CrashBuffer& buf, const string& str) {
+  for (char chr : str)
+    if (chr != ' ' && chr != '=' && chr != ',')
+      buf.Append(chr);
+}
+
 //-----------------------------------------------------------------------------
 /*! \brief Constructor
   \throws Exception in case Monitor is already instantiated
@@ -116,6 +160,7 @@ Monitor::Monitor() {
 
   // start EventLoop
   fThread = thread([this]() { EventLoop(); });
+  CrashHandler::AddHook(&Monitor::CrashHook, this);
 
   fpSingleton = this;
 }
@@ -128,6 +173,7 @@ Monitor::Monitor() {
  */
 
 Monitor::~Monitor() {
+  CrashHandler::RemoveHook(this);
   fpSingleton = nullptr;
   Stop();
 }
@@ -140,6 +186,16 @@ Monitor::~Monitor() {
   - `file`: will create a MonitorSinkFile sink
   - `influx1`: will create a MonitorSinkInflux1 sink
   - `influx2`: will create a MonitorSinkInflux2 sink
+  - `influxshard`: will create a MonitorSinkInfluxShard sink
+  - `udp`: will create a MonitorSinkUdp sink
+  - `unix`: will create a MonitorSinkUnix sink
+  - `prom`: will create a MonitorSinkProm sink
+  - `statsd`: will create a MonitorSinkStatsd sink
+  - `shm`: will create a MonitorSinkShm sink
+  - `agent`: will create a MonitorSinkAgent sink
+
+  The `path` part may be followed by sink specific options given as
+  `?key=value&...`, see SinkOptions.
  */
 
 void Monitor::OpenSink(const string& sname) {
@@ -175,6 +231,37 @@ void Monitor::OpenSink(const string& sname) {
         make_unique<MonitorSinkInflux2>(*this, spath);
     lock_guard<mutex> lock(fSinkMapMutex);
     fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "influxshard") {
+    unique_ptr<MonitorSink> uptr =
+        make_unique<MonitorSinkInfluxShard>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "udp") {
+    unique_ptr<MonitorSink> uptr = make_unique<MonitorSinkUdp>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "unix") {
+    unique_ptr<MonitorSink> uptr = make_unique<MonitorSinkUnix>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "prom") {
+    unique_ptr<MonitorSink> uptr = make_unique<MonitorSinkProm>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "statsd") {
+    unique_ptr<MonitorSink> uptr =
+        make_unique<MonitorSinkStatsd>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "shm") {
+    unique_ptr<MonitorSink> uptr = make_unique<MonitorSinkShm>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
+  } else if (stype == "agent") {
+    unique_ptr<MonitorSink> uptr =
+        make_unique<MonitorSinkAgent>(*this, spath);
+    lock_guard<mutex> lock(fSinkMapMutex);
+    fSinkMap.try_emplace(sname, move(uptr));
   } else {
     throw Exception(
         fmt::format("Monitor::OpenSink: invalid sink type '{}'", stype));
@@ -228,6 +315,7 @@ void Monitor::QueueMetric(Metric&& point) {
     ts = ScNow();
   {
     lock_guard<mutex> lock(fMetVecMutex);
+    MetVecBusy busy(fMetVecBusy, fCrashPark);
     fMetVec.emplace_back(move(point));
     fMetVec[fMetVec.size() - 1].fTimestamp = ts;
   }
@@ -337,6 +425,7 @@ void Monitor::EventLoop() {
     metvec_t metvec;
     {
       lock_guard<mutex> lock(fMetVecMutex);
+      MetVecBusy busy(fMetVecBusy, fCrashPark);
       if (!fMetVec.empty()) {
         // move whole vector from protected queue to local environment
         metvec.swap(fMetVec);
@@ -385,6 +474,84 @@ MonitorSink& Monitor::SinkRef(const string& sname) {
   return *(it->second.get());
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief CrashHandler hook, writes the queued metrics
+  \param ctx   the Monitor
+  \param buf   output buffer
+
+  Runs in a signal handler, so `fMetVecMutex` can't be used. Instead the
+  hook sets `fCrashPark`, which makes any thread about to modify the queue
+  wait, and then waits up to 100 ms until the thread currently modifying
+  it, if any, is done. If the queue is still busy after that, e.g. because
+  the crash happened while the queue was modified, it is not written. The
+  waiting threads are released when the hook returns.
+
+  The metrics are written in InfluxDB line format. As in
+  MonitorSink::InfluxLine() ' ', '=' and ',' are removed from names and tag
+  values, in string field values '"' and '\\' are escaped.
+ */
+
+void Monitor::CrashHook(void* ctx, CrashBuffer& buf) {
+  Monitor& self = *static_cast<Monitor*>(ctx);
+  self.fCrashPark.store(true);
+  for (int i = 0; i < 100 && self.fMetVecBusy.load(); i++) {
+    timespec ts{0, 1000000};
+    (void)::nanosleep(&ts, nullptr);
+  }
+  if (self.fMetVecBusy.load()) {
+    buf.Append("Monitor: queue busy, not written\n");
+    self.fCrashPark.store(false);
+    return;
+  }
+
+  for (const auto& met : self.fMetVec) {
+    AppendClean(buf, met.fMeasurement);
+    for (const auto& tag : met.fTagset) {
+      buf.Append(',');
+      AppendClean(buf, tag.first);
+      buf.Append('=');
+      AppendClean(buf, tag.second);
+    }
+    char sep = ' ';
+    for (const auto& field : met.fFieldset) {
+      buf.Append(sep);
+      AppendClean(buf, field.first);
+      buf.Append('=');
+      const MetricField& val = field.second;
+      if (auto pval = get_if<bool>(&val)) {
+        buf.Append(*pval ? "true" : "false");
+      } else if (auto pval = get_if<int>(&val)) {
+        buf.AppendInt(*pval);
+        buf.Append('i');
+      } else if (auto pval = get_if<long>(&val)) {
+        buf.AppendInt(*pval);
+        buf.Append('i');
+      } else if (auto pval = get_if<unsigned long>(&val)) {
+        buf.AppendUInt(*pval);
+        buf.Append('i');
+      } else if (auto pval = get_if<double>(&val)) {
+        buf.AppendDouble(*pval);
+      } else if (auto pval = get_if<string>(&val)) {
+        buf.Append('"');
+        for (char chr : *pval) {
+          if (chr == '"' || chr == '\\')
+            buf.Append('\\');
+          buf.Append(chr);
+        }
+        buf.Append('"');
+      }
+      sep = ',';
+    }
+    buf.Append(' ');
+    buf.AppendInt(ScTimePoint2Nsec(met.fTimestamp));
+    buf.Append('\n');
+  }
+  buf.Append("Monitor: ");
+  buf.AppendUInt(self.fMetVec.size());
+  buf.Append(" queued metrics written\n");
+  self.fCrashPark.store(false);
+}
+
 //-----------------------------------------------------------------------------
 // define static member variables
 
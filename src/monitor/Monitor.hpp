@@ -6,10 +6,12 @@
 #define included_Cbm_Monitor 1
 
 #include "ChronoDefs.hpp"
+#include "CrashHandler.hpp"
 #include "FileDescriptor.hpp"
 #include "Metric.hpp"
 #include "MonitorSink.hpp"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -62,22 +64,25 @@ private:
   void Wakeup();
   void EventLoop();
   MonitorSink& SinkRef(const string& sname);
+  static void CrashHook(void* ctx, CrashBuffer& buf);
 
 private:
   using metvec_t = vector<Metric>;
   using sink_uptr_t = unique_ptr<MonitorSink>;
   using smap_t = unordered_map<string, sink_uptr_t>;
 
-  FileDescriptor fEvtFd{};       //!< fd for eventfd file
-  thread fThread{};              //!< worker thread
-  metvec_t fMetVec{};            //!< metric list
-  mutex fMetVecMutex{};          //!< mutex for fMetVec access
-  string fHostName{""};          //!< hostname
-  bool fStopped{false};          //!< signals thread rundown
-  smap_t fSinkMap{};             //!< sink registry
-  mutex fSinkMapMutex{};         //!< mutex for fSinkMap access
-  sctime_point fNextHeartbeat{}; //!< time of next heartbeat
-  static Monitor* fpSingleton;   //!< \glos{singleton} this
+  FileDescriptor fEvtFd{};         //!< fd for eventfd file
+  thread fThread{};                //!< worker thread
+  metvec_t fMetVec{};              //!< metric list
+  mutex fMetVecMutex{};            //!< mutex for fMetVec access
+  atomic<bool> fMetVecBusy{false}; //!< fMetVec is modified
+  atomic<bool> fCrashPark{false};  //!< CrashHook() reads fMetVec
+  string fHostName{""};            //!< hostname
+  bool fStopped{false};            //!< signals thread rundown
+  smap_t fSinkMap{};               //!< sink registry
+  mutex fSinkMapMutex{};           //!< mutex for fSinkMap access
+  sctime_point fNextHeartbeat{};   //!< time of next heartbeat
+  static Monitor* fpSingleton;     //!< \glos{singleton} this
 };
 
 } // end namespace cbm
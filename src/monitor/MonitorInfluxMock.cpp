@@ -0,0 +1,579 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorInfluxMock.hpp"
+
+#include "Exception.hpp"
+#include "PThreadHelper.hpp"
+#include "SysCallException.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace cbm {
+using namespace std;
+
+// some constants
+static const size_t kMaxHeadSize = 65536; // limit for HTTP request head
+
+/*! \class MonitorInfluxMock
+  \brief Local stand-in for an InfluxDB write endpoint
+
+  A small HTTP server which accepts the write requests of MonitorSinkInflux1
+  (`/write`) and MonitorSinkInflux2 (`/api/v2/write`). It counts requests,
+  lines and bytes and validates each line against the InfluxDB line
+  protocol. It allows to benchmark the sinks and to test their failure
+  handling without a database. It can be used as fixture in a program, see
+  `app/monitor_tester`, or standalone via `app/influx_mock`.
+
+  The server listens on the loopback interface and serves each connection
+  in its own thread, HTTP keep-alive is supported. A request gets
+  - `404 Not Found` for other targets than the two write endpoints
+  - `413 Request Entity Too Large` if the body exceeds SetMaxBody()
+  - `400 Bad Request` if the body contains an invalid line, or if a body
+    sent with `Content-Encoding: gzip` can't be decompressed
+  - `204 No Content` otherwise
+
+  The byte count is the size of the body as sent, before decompression.
+
+  Faults can be injected, the random decisions use a generator with a fixed
+  seed (see SetSeed()), so a run is reproducible for a given request order:
+  - SetLatency(): delays each response
+  - SetErrorStatus(): responds with a given status at a given rate
+  - SetResetRate(): resets the connection at a given rate, no response
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param port   port to listen on, 0 selects a free port (see Port())
+  \throws SysCallException in case a system calls fails
+
+  Sets up the listen socket and starts the accept thread.
+ */
+
+MonitorInfluxMock::MonitorInfluxMock(int port) {
+  int fd = ::eventfd(0U, 0);
+  if (fd < 0)
+    throw SysCallException("MonitorInfluxMock::ctor"s, "eventfd"s, errno);
+  fEvtFd.Set(fd);
+
+  fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    throw SysCallException("MonitorInfluxMock::ctor"s, "socket"s, errno);
+  fListenFd.Set(fd);
+
+  int one = 1;
+  (void)::setsockopt(fListenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(uint16_t(port));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::bind(fListenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    throw SysCallException("MonitorInfluxMock::ctor"s, "bind"s,
+                           fmt::format("port {}", port), errno);
+  if (::listen(fListenFd, 64) < 0)
+    throw SysCallException("MonitorInfluxMock::ctor"s, "listen"s, errno);
+  socklen_t len = sizeof(addr);
+  if (::getsockname(fListenFd, reinterpret_cast<sockaddr*>(&addr), &len) < 0)
+    throw SysCallException("MonitorInfluxMock::ctor"s, "getsockname"s, errno);
+  fPort = ntohs(addr.sin_port);
+
+  fThread = thread([this]() { AcceptLoop(); });
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor
+
+  Calls Stop(), which closes all connections and terminates all threads.
+  An error of Stop() is reported on `std::cerr`.
+ */
+
+MonitorInfluxMock::~MonitorInfluxMock() {
+  try {
+    Stop();
+  } catch (const SysCallException& e) {
+    std::cerr << "MonitorInfluxMock::dtor: " << e.what() << "\n";
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Set response delay
+  \param latency   delay in s applied before each response
+ */
+
+void MonitorInfluxMock::SetLatency(double latency) {
+  lock_guard<mutex> lock(fMutex);
+  fLatency = latency;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Set injected error responses
+  \param status   HTTP status of injected error responses, e.g. 503
+  \param rate     probability of an error response for a request
+ */
+
+void MonitorInfluxMock::SetErrorStatus(unsigned status, double rate) {
+  lock_guard<mutex> lock(fMutex);
+  fErrStatus = status;
+  fErrRate = rate;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Set injected connection resets
+  \param rate     probability of a connection reset for a request
+ */
+
+void MonitorInfluxMock::SetResetRate(double rate) {
+  lock_guard<mutex> lock(fMutex);
+  fResetRate = rate;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Set body size limit
+  \param nbyte    bodies larger than `nbyte` get a 413, 0 disables the limit
+ */
+
+void MonitorInfluxMock::SetMaxBody(size_t nbyte) {
+  lock_guard<mutex> lock(fMutex);
+  fMaxBody = nbyte;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Set seed of the random generator used for fault injection
+ */
+
+void MonitorInfluxMock::SetSeed(unsigned seed) {
+  lock_guard<mutex> lock(fMutex);
+  fRng.seed(seed);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns a snapshot of the statistics
+
+MonitorInfluxMock::Stats MonitorInfluxMock::Statistics() {
+  lock_guard<mutex> lock(fMutex);
+  return fStats;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Clears the statistics
+
+void MonitorInfluxMock::ClearStatistics() {
+  lock_guard<mutex> lock(fMutex);
+  fStats = Stats();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Checks whether `line` is valid InfluxDB line protocol
+  \param line   one line, without the trailing newline
+  \returns `true` if valid
+
+  Checks the structure `measurement[,tag=value...] field=value[,...] [time]`
+  with backslash escapes in names, quoted string field values, and the
+  field value types float, integer (`i`), unsigned (`u`) and boolean.
+ */
+
+bool MonitorInfluxMock::ValidLine(string_view line) {
+  size_t pos = 0;
+  // scan a name or tag value up to an unescaped character of `stop`
+  auto scan = [&line, &pos](string_view stop) {
+    size_t pbeg = pos;
+    while (pos < line.size() && stop.find(line[pos]) == string_view::npos) {
+      if (line[pos] == '\\')
+        pos += 1;
+      pos += 1;
+    }
+    pos = min(pos, line.size());
+    return line.substr(pbeg, pos - pbeg);
+  };
+
+  if (scan(", ").empty()) // measurement
+    return false;
+  while (pos < line.size() && line[pos] == ',') { // tag set
+    pos += 1;
+    if (scan("=,").empty() || pos >= line.size() || line[pos] != '=')
+      return false;
+    pos += 1;
+    if (scan(", ").empty())
+      return false;
+  }
+  if (pos >= line.size() || line[pos] != ' ')
+    return false;
+
+  while (true) { // field set
+    pos += 1;
+    if (scan("=").empty() || pos >= line.size())
+      return false;
+    pos += 1;
+    if (pos < line.size() && line[pos] == '"') { // string value
+      pos += 1;
+      while (pos < line.size() && line[pos] != '"')
+        pos += (line[pos] == '\\') ? 2 : 1;
+      if (pos >= line.size())
+        return false;
+      pos += 1;
+    } else {
+      string val(scan(", "));
+      if (val.empty())
+        return false;
+      static const char* const bools[] = {"t",    "T",    "true", "True",
+                                          "TRUE", "f",    "F",    "false",
+                                          "False", "FALSE"};
+      bool ok = find(begin(bools), end(bools), val) != end(bools);
+      if (!ok) {
+        char last = val.back();
+        if (last == 'i' || last == 'u') {
+          val.pop_back();
+          char* pend = nullptr;
+          if (last == 'i')
+            (void)::strtol(val.c_str(), &pend, 10);
+          else
+            (void)::strtoul(val.c_str(), &pend, 10);
+          ok = !val.empty() && *pend == '\0' &&
+               (last == 'i' || val.find('-') == string::npos);
+        } else {
+          char* pend = nullptr;
+          (void)::strtod(val.c_str(), &pend);
+          ok = *pend == '\0';
+        }
+      }
+      if (!ok)
+        return false;
+    }
+    if (pos >= line.size())
+      return true;
+    if (line[pos] == ' ')
+      break;
+    if (line[pos] != ',')
+      return false;
+  }
+
+  string tstamp(line.substr(pos + 1)); // timestamp
+  if (tstamp.empty())
+    return false;
+  char* pend = nullptr;
+  (void)::strtol(tstamp.c_str(), &pend, 10);
+  return *pend == '\0';
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Decompress a gzip body
+  \param zbody  compressed body
+  \param body   returns the decompressed body
+  \returns `false` if `zbody` is not valid gzip data
+ */
+
+bool MonitorInfluxMock::Gunzip(const string& zbody, string& body) {
+  z_stream zs{};
+  // windowBits 15 + 16 accepts only the gzip format
+  if (inflateInit2(&zs, 15 + 16) != Z_OK)
+    return false;
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(zbody.data()));
+  zs.avail_in = uInt(zbody.size());
+  body.clear();
+  int rc = Z_OK;
+  while (rc == Z_OK) {
+    size_t nold = body.size();
+    body.resize(nold + max(size_t(65536), 4 * zbody.size()));
+    zs.next_out = reinterpret_cast<Bytef*>(body.data() + nold);
+    zs.avail_out = uInt(body.size() - nold);
+    rc = inflate(&zs, Z_NO_FLUSH);
+    body.resize(body.size() - zs.avail_out);
+  }
+  inflateEnd(&zs);
+  return rc == Z_STREAM_END && zs.avail_in == 0;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Stop server
+  \throws SysCallException if the wakeup of the server thread failed, the
+    server is stopped anyway
+
+  Closes the listen socket and all connections and waits until all threads
+  terminated. When the write to the eventfd fails the server thread is
+  woken by a shutdown of the listen socket instead.
+ */
+
+void MonitorInfluxMock::Stop() {
+  fStopped = true;
+  uint64_t one(1);
+  int eno = 0;
+  if (::write(fEvtFd, &one, sizeof(one)) != sizeof(one)) {
+    eno = errno;
+    (void)::shutdown(fListenFd, SHUT_RDWR); // also wakes the poll()
+  }
+  if (fThread.joinable())
+    fThread.join();
+
+  {
+    unique_lock<mutex> lock(fConnMutex);
+    for (int fd : fConnFds)
+      (void)::shutdown(fd, SHUT_RDWR);
+    fConnCond.wait(lock, [this]() { return fConnFds.empty(); });
+  }
+  if (eno != 0)
+    throw SysCallException("MonitorInfluxMock::Stop"s, "write"s, "fEvtFd"s,
+                           eno);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief The accept loop of the server thread
+ */
+
+void MonitorInfluxMock::AcceptLoop() {
+  SetPThreadName("Cbm:influxmock");
+
+  pollfd polllist[2];
+  polllist[0] = pollfd{fEvtFd, POLLIN, 0};
+  polllist[1] = pollfd{fListenFd, POLLIN, 0};
+
+  while (!fStopped) {
+    if (::poll(polllist, 2, -1) < 0)
+      continue; // EINTR
+    if (polllist[0].revents)
+      break;
+    if (!(polllist[1].revents & POLLIN))
+      continue;
+    int fd = ::accept4(fListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+      continue;
+    {
+      lock_guard<mutex> lock(fConnMutex);
+      fConnFds.insert(fd);
+    }
+    {
+      lock_guard<mutex> lock(fMutex);
+      fStats.fNConn += 1;
+    }
+    thread([this, fd]() { Serve(fd); }).detach();
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Serve all requests of a connection
+  \param fd   fd of connection socket, closed when done
+ */
+
+void MonitorInfluxMock::Serve(int fd) {
+  string buf;
+  string head;
+  string body;
+
+  while (ReadRequest(fd, buf, head, body)) {
+    // request line: method target version
+    size_t pend = head.find("\r\n");
+    string reqline = head.substr(0, pend);
+    size_t p1 = reqline.find(' ');
+    size_t p2 = reqline.find(' ', p1 == string::npos ? p1 : p1 + 1);
+    string method = reqline.substr(0, p1);
+    string target =
+        p1 == string::npos ? ""s : reqline.substr(p1 + 1, p2 - p1 - 1);
+    string tpath = target.substr(0, target.find('?'));
+    bool keepalive = reqline.find("HTTP/1.0") == string::npos;
+    if (strcasestr(head.c_str(), "\r\nConnection: close"))
+      keepalive = false;
+
+    double latency = 0.;
+    unsigned status = 204;
+    string rbody;
+    bool reset = false;
+    {
+      lock_guard<mutex> lock(fMutex);
+      latency = fLatency;
+      if (method != "POST" || (tpath != "/write" && tpath != "/api/v2/write")) {
+        status = 404;
+      } else {
+        fStats.fNRequest += 1;
+        if (fMaxBody > 0 && body.size() > fMaxBody) {
+          status = 413;
+        } else if (fResetRate > 0. && Random() < fResetRate) {
+          fStats.fNReset += 1;
+          reset = true;
+        } else if (fErrRate > 0. && Random() < fErrRate) {
+          fStats.fNError += 1;
+          status = fErrStatus;
+        }
+      }
+    }
+
+    if (latency > 0.)
+      this_thread::sleep_for(chrono::duration<double>(latency));
+    if (reset) {
+      ResetConnection(fd);
+      fd = -1;
+      break;
+    }
+
+    string zbody;
+    if (status == 204 &&
+        strcasestr(head.c_str(), "\r\nContent-Encoding: gzip")) {
+      zbody.swap(body);
+      if (!Gunzip(zbody, body)) {
+        status = 400;
+        rbody = "{\"error\":\"invalid gzip body\"}";
+      }
+    }
+
+    if (status == 204) { // validate and count lines
+      long nline = 0;
+      long nbad = 0;
+      string_view bview(body);
+      size_t pbeg = 0;
+      while (pbeg < bview.size()) {
+        size_t pnl = bview.find('\n', pbeg);
+        if (pnl == string_view::npos)
+          pnl = bview.size();
+        auto line = bview.substr(pbeg, pnl - pbeg);
+        pbeg = pnl + 1;
+        if (line.empty())
+          continue;
+        if (ValidLine(line)) {
+          nline += 1;
+        } else {
+          if (nbad == 0)
+            rbody = fmt::format("{{\"error\":\"invalid line '{}'\"}}",
+                                string(line.substr(0, 80)));
+          nbad += 1;
+        }
+      }
+      if (nbad > 0)
+        status = 400;
+      lock_guard<mutex> lock(fMutex);
+      fStats.fNLine += nline;
+      fStats.fNBadLine += nbad;
+      fStats.fNByte += long(zbody.empty() ? body.size() : zbody.size());
+    } else if (status != 404 && rbody.empty()) {
+      rbody = fmt::format("{{\"error\":\"mock status {}\"}}", status);
+    }
+
+    if (!WriteResponse(fd, status, rbody) || !keepalive)
+      break;
+  }
+
+  lock_guard<mutex> lock(fConnMutex);
+  if (fd >= 0) {
+    fConnFds.erase(fd);
+    (void)::close(fd);
+  }
+  fConnCond.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Read one request from a connection
+  \param fd     fd of connection socket
+  \param buf    receive buffer, holds data read ahead across requests
+  \param head   returns the request head
+  \param body   returns the request body
+  \returns `false` on end of connection or malformed request
+ */
+
+bool MonitorInfluxMock::ReadRequest(int fd,
+                                    string& buf,
+                                    string& head,
+                                    string& body) {
+  char rbuf[65536];
+  auto fill = [fd, &buf, &rbuf]() {
+    ssize_t nrd = ::recv(fd, rbuf, sizeof(rbuf), 0);
+    if (nrd <= 0)
+      return false;
+    buf.append(rbuf, size_t(nrd));
+    return true;
+  };
+
+  size_t phead = 0;
+  while ((phead = buf.find("\r\n\r\n")) == string::npos) {
+    if (buf.size() > kMaxHeadSize || !fill())
+      return false;
+  }
+  head = buf.substr(0, phead + 2);
+  buf.erase(0, phead + 4);
+
+  size_t nbody = 0;
+  const char* pcl = strcasestr(head.c_str(), "\r\nContent-Length:");
+  if (pcl)
+    nbody = size_t(::strtoul(pcl + 17, nullptr, 10));
+  while (buf.size() < nbody)
+    if (!fill())
+      return false;
+  body = buf.substr(0, nbody);
+  buf.erase(0, nbody);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Write a response
+  \param fd       fd of connection socket
+  \param status   HTTP status
+  \param body     response body, sent as `application/json` if not empty
+  \returns `false` if the write failed
+ */
+
+bool MonitorInfluxMock::WriteResponse(int fd,
+                                      unsigned status,
+                                      const string& body) {
+  const char* reason = "Error";
+  switch (status) {
+  case 200: reason = "OK"; break;
+  case 204: reason = "No Content"; break;
+  case 400: reason = "Bad Request"; break;
+  case 404: reason = "Not Found"; break;
+  case 413: reason = "Request Entity Too Large"; break;
+  case 429: reason = "Too Many Requests"; break;
+  case 500: reason = "Internal Server Error"; break;
+  case 503: reason = "Service Unavailable"; break;
+  }
+  string msg = fmt::format("HTTP/1.1 {} {}\r\n", status, reason);
+  if (!body.empty())
+    msg += "Content-Type: application/json\r\n";
+  msg += fmt::format("Content-Length: {}\r\n\r\n", body.size());
+  msg += body;
+
+  size_t nwr = 0;
+  while (nwr < msg.size()) {
+    ssize_t rc = ::send(fd, msg.data() + nwr, msg.size() - nwr, MSG_NOSIGNAL);
+    if (rc < 0)
+      return false;
+    nwr += size_t(rc);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Reset a connection
+  \param fd       fd of connection socket, will be closed
+
+  Uses `SO_LINGER` with a zero timeout, so `close(2)` sends a TCP RST.
+ */
+
+void MonitorInfluxMock::ResetConnection(int fd) {
+  linger lin{1, 0};
+  (void)::setsockopt(fd, SOL_SOCKET, SO_LINGER, &lin, sizeof(lin));
+  lock_guard<mutex> lock(fConnMutex);
+  fConnFds.erase(fd);
+  (void)::close(fd);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns a uniform random number in [0,1), call with fMutex locked
+ */
+
+double MonitorInfluxMock::Random() {
+  return uniform_real_distribution<double>(0., 1.)(fRng);
+}
+
+} // end namespace cbm
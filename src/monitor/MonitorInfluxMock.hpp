@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorInfluxMock
+#define included_Cbm_MonitorInfluxMock 1
+
+#include "FileDescriptor.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace cbm {
+using namespace std;
+
+class MonitorInfluxMock {
+public:
+  struct Stats {
+    long fNRequest{0}; //!< # of write requests
+    long fNLine{0};    //!< # of valid lines
+    long fNBadLine{0}; //!< # of invalid lines
+    long fNByte{0};    //!< # of body bytes
+    long fNError{0};   //!< # of injected error responses
+    long fNReset{0};   //!< # of injected connection resets
+    long fNConn{0};    //!< # of accepted connections
+  };
+
+  explicit MonitorInfluxMock(int port = 0);
+  virtual ~MonitorInfluxMock();
+
+  MonitorInfluxMock(const MonitorInfluxMock&) = delete;
+  MonitorInfluxMock& operator=(const MonitorInfluxMock&) = delete;
+
+  int Port() const;
+  void SetLatency(double latency);
+  void SetErrorStatus(unsigned status, double rate);
+  void SetResetRate(double rate);
+  void SetMaxBody(size_t nbyte);
+  void SetSeed(unsigned seed);
+  Stats Statistics();
+  void ClearStatistics();
+
+  static bool ValidLine(string_view line);
+  static bool Gunzip(const string& zbody, string& body);
+
+private:
+  void Stop();
+  void AcceptLoop();
+  void Serve(int fd);
+  bool ReadRequest(int fd, string& buf, string& head, string& body);
+  bool WriteResponse(int fd, unsigned status, const string& body);
+  void ResetConnection(int fd);
+  double Random();
+
+private:
+  FileDescriptor fListenFd{};     //!< fd of listen socket
+  FileDescriptor fEvtFd{};        //!< fd for eventfd, signals stop
+  int fPort{0};                   //!< bound port
+  thread fThread{};               //!< accept thread
+  mutex fConnMutex{};             //!< mutex for connection set
+  condition_variable fConnCond{}; //!< signals connection end
+  set<int> fConnFds{};            //!< fds of active connections
+  atomic<bool> fStopped{false};   //!< signals thread rundown
+  mutex fMutex{};                 //!< mutex for settings and stats
+  double fLatency{0.};            //!< response delay (in s)
+  unsigned fErrStatus{503};       //!< status of injected errors
+  double fErrRate{0.};            //!< probability of injected errors
+  double fResetRate{0.};          //!< probability of injected resets
+  size_t fMaxBody{0};             //!< body limit for 413, 0 if none
+  mt19937 fRng{1};                //!< random generator for injection
+  Stats fStats{};                 //!< statistics
+};
+
+} // end namespace cbm
+
+#include "MonitorInfluxMock.ipp"
+
+#endif
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the port the server listens on
+
+inline int MonitorInfluxMock::Port() const { return fPort; }
+
+} // end namespace cbm
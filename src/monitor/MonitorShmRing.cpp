@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorShmRing.hpp"
+
+#include "Exception.hpp"
+#include "SysCallException.hpp"
+
+#include "fmt/format.h"
+
+#include <cstring>
+#include <new>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const uint64_t kMagic = 0x474e5252444d4243ULL; // "CBMDRRNG"
+static const uint32_t kVersion = 1;                   // layout version
+static const uint32_t kPadMark = 0xffffffffU;         // length of pad record
+static const size_t kLenSize = sizeof(uint32_t);      // size of length word
+
+static_assert(atomic<uint64_t>::is_always_lock_free,
+              "shared memory ring requires lock-free 64 bit atomics");
+
+// record size: length word plus payload, rounded up to 8 bytes
+static inline uint64_t RecordSize(uint64_t nbyte) {
+  return (kLenSize + nbyte + 7) & ~uint64_t(7);
+}
+
+/*! \class MonitorShmRing
+  \brief Single producer ring buffer of records in POSIX shared memory
+
+  Transfers variable size records from one writer process to one reader
+  process via a POSIX shared memory segment, without system calls and
+  without locks. Used by MonitorSinkShm as writer and by the
+  `monitor_shmcat` tool as reader.
+
+  The segment holds a header and a data area with a power of 2 size. The
+  write position `head` and the read position `tail` are byte counters,
+  which are only incremented. Each record is a 32 bit length word followed
+  by the payload, padded to 8 bytes. A record is never split at the end of
+  the data area, the remaining space is filled by a pad record instead.
+
+  The writer never waits for the reader. When the ring is full the writer
+  advances `tail` itself over the oldest records and counts them as
+  overwritten. Both writer and reader advance `tail` with a compare and
+  swap. The reader copies a record and then tries to advance `tail`; when
+  that fails the writer has reclaimed the record meanwhile and the copy,
+  which might be torn, is discarded.
+
+  The segment is not removed when the writer closes, so a reader can drain
+  it after the writer ended. It is removed with Unlink(). When a writer
+  creates a ring with the name of an existing segment the old segment is
+  unlinked first, a reader still attached to it is not disturbed.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor for the writer, creates the segment
+  \param name       ring name, see ShmName()
+  \param capacity   size of the data area, rounded up to a power of 2
+  \throws SysCallException in case a system call fails
+ */
+
+MonitorShmRing::MonitorShmRing(const string& name, size_t capacity)
+    : fName(ShmName(name)) {
+  size_t cap = 4096;
+  while (cap < capacity)
+    cap *= 2;
+
+  (void)::shm_unlink(fName.c_str());
+  int fd = ::shm_open(fName.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC,
+                      0660);
+  if (fd < 0)
+    throw SysCallException("MonitorShmRing::ctor"s, "shm_open"s, fName, errno);
+  size_t size = sizeof(Header) + cap;
+  if (::ftruncate(fd, off_t(size)) < 0) {
+    int eno = errno;
+    (void)::close(fd);
+    (void)::shm_unlink(fName.c_str());
+    throw SysCallException("MonitorShmRing::ctor"s, "ftruncate"s, fName, eno);
+  }
+  Map(fd, size);
+
+  // the segment is zero filled, so only non-zero fields are set
+  new (fpHeader) Header{};
+  fpHeader->fVersion = kVersion;
+  fpHeader->fCapacity = cap;
+  fpHeader->fWriterPid = ::getpid();
+  fpHeader->fMagic.store(kMagic, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor for the reader, attaches to an existing segment
+  \param name       ring name, see ShmName()
+  \throws SysCallException in case a system call fails
+  \throws Exception if the segment is not a ring of this version
+ */
+
+MonitorShmRing::MonitorShmRing(const string& name) : fName(ShmName(name)) {
+  int fd = ::shm_open(fName.c_str(), O_RDWR | O_CLOEXEC, 0);
+  if (fd < 0)
+    throw SysCallException("MonitorShmRing::ctor"s, "shm_open"s, fName, errno);
+  struct stat sbuf;
+  if (::fstat(fd, &sbuf) < 0) {
+    int eno = errno;
+    (void)::close(fd);
+    throw SysCallException("MonitorShmRing::ctor"s, "fstat"s, fName, eno);
+  }
+  if (size_t(sbuf.st_size) <= sizeof(Header)) {
+    (void)::close(fd);
+    throw Exception(
+        fmt::format("MonitorShmRing::ctor: segment '{}' too small", fName));
+  }
+  Map(fd, size_t(sbuf.st_size));
+  uint64_t magic = fpHeader->fMagic.load(memory_order_acquire);
+  if (magic != kMagic || fpHeader->fVersion != kVersion ||
+      sizeof(Header) + fpHeader->fCapacity != fMapSize)
+    throw Exception(fmt::format("MonitorShmRing::ctor: segment '{}' is not a"
+                                " ring of version {}",
+                                fName, kVersion));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor, unmaps the segment
+ */
+
+MonitorShmRing::~MonitorShmRing() {
+  if (fpHeader)
+    (void)::munmap(fpHeader, fMapSize);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Write a record (writer only)
+  \param payload   record data
+  \returns `false` if the record is larger than half the capacity and was
+    dropped
+
+  Never blocks. When needed the oldest records are overwritten.
+ */
+
+bool MonitorShmRing::Write(string_view payload) {
+  Header& hdr = *fpHeader;
+  uint64_t cap = hdr.fCapacity;
+  uint64_t recsize = RecordSize(payload.size());
+  if (recsize > cap / 2 || payload.size() >= kPadMark) {
+    hdr.fNDrop.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+
+  uint64_t head = hdr.fHead.load(memory_order_relaxed);
+  uint64_t off = head & (cap - 1);
+  uint64_t npad = off + recsize > cap ? cap - off : 0;
+
+  // reclaim space by advancing tail over the oldest records
+  uint64_t tail = hdr.fTail.load(memory_order_acquire);
+  while (head + npad + recsize - tail > cap) {
+    uint64_t toff = tail & (cap - 1);
+    uint32_t len = LoadLength(tail);
+    uint64_t step = len == kPadMark ? cap - toff : RecordSize(len);
+    if (hdr.fTail.compare_exchange_weak(tail, tail + step,
+                                        memory_order_acq_rel)) {
+      if (len != kPadMark) {
+        hdr.fNOverwrite.fetch_add(1, memory_order_relaxed);
+        hdr.fNOverwriteByte.fetch_add(len, memory_order_relaxed);
+      }
+      tail += step;
+    } // else tail was reloaded by compare_exchange
+  }
+
+  uint8_t* data = Data();
+  if (npad > 0) {
+    memcpy(data + off, &kPadMark, kLenSize);
+    head += npad;
+    off = 0;
+  }
+  uint32_t len = uint32_t(payload.size());
+  memcpy(data + off, &len, kLenSize);
+  memcpy(data + off + kLenSize, payload.data(), payload.size());
+  hdr.fHead.store(head + recsize, memory_order_release);
+  hdr.fNWrite.fetch_add(1, memory_order_relaxed);
+  hdr.fNWriteByte.fetch_add(payload.size(), memory_order_relaxed);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Read the oldest record (reader only)
+  \param payload   returns the record data
+  \returns `false` if the ring is empty
+  \throws Exception if the ring content is inconsistent
+ */
+
+bool MonitorShmRing::Read(string& payload) {
+  Header& hdr = *fpHeader;
+  uint64_t cap = hdr.fCapacity;
+  uint8_t* data = Data();
+
+  while (true) {
+    uint64_t tail = hdr.fTail.load(memory_order_acquire);
+    uint64_t head = hdr.fHead.load(memory_order_acquire);
+    if (tail == head)
+      return false;
+
+    uint64_t toff = tail & (cap - 1);
+    uint32_t len = LoadLength(tail);
+    uint64_t step = 0;
+    if (len == kPadMark) {
+      step = cap - toff;
+    } else {
+      step = RecordSize(len);
+      if (toff + step > cap || tail + step > head) { // torn length word
+        if (hdr.fTail.load(memory_order_acquire) == tail)
+          throw Exception(fmt::format("MonitorShmRing::Read: corrupt record"
+                                      " at {} in '{}'",
+                                      tail, fName));
+        continue;
+      }
+      payload.assign(reinterpret_cast<const char*>(data + toff + kLenSize),
+                     len);
+    }
+    // the copy is valid only if the writer did not reclaim the record
+    atomic_thread_fence(memory_order_acquire);
+    if (hdr.fTail.compare_exchange_strong(tail, tail + step,
+                                          memory_order_acq_rel) &&
+        len != kPadMark)
+      return true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns a snapshot of the ring statistics
+
+MonitorShmRing::Stats MonitorShmRing::Statistics() const {
+  const Header& hdr = *fpHeader;
+  Stats res;
+  res.fNWrite = hdr.fNWrite.load(memory_order_relaxed);
+  res.fNWriteByte = hdr.fNWriteByte.load(memory_order_relaxed);
+  res.fNOverwrite = hdr.fNOverwrite.load(memory_order_relaxed);
+  res.fNOverwriteByte = hdr.fNOverwriteByte.load(memory_order_relaxed);
+  res.fNDrop = hdr.fNDrop.load(memory_order_relaxed);
+  res.fFill = hdr.fHead.load(memory_order_relaxed) -
+              hdr.fTail.load(memory_order_relaxed);
+  res.fCapacity = hdr.fCapacity;
+  res.fWriterPid = pid_t(hdr.fWriterPid);
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns `true` if the writer process is still running
+ */
+
+bool MonitorShmRing::WriterAlive() const {
+  pid_t pid = pid_t(fpHeader->fWriterPid);
+  return ::kill(pid, 0) == 0 || errno == EPERM;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Removes the shm object name, the mapping stays valid
+ */
+
+void MonitorShmRing::Unlink() { (void)::shm_unlink(fName.c_str()); }
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the shm object name for a ring name
+
+  The shm object name is `/cbmmon_<name>`, the object is visible as
+  `/dev/shm/cbmmon_<name>`.
+ */
+
+string MonitorShmRing::ShmName(const string& name) {
+  return "/cbmmon_"s + name;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Maps the segment and closes the fd
+ */
+
+void MonitorShmRing::Map(int fd, size_t size) {
+  void* addr =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int eno = errno;
+  (void)::close(fd);
+  if (addr == MAP_FAILED)
+    throw SysCallException("MonitorShmRing::Map"s, "mmap"s, fName, eno);
+  fpHeader = static_cast<Header*>(addr);
+  fMapSize = size;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the length word of the record at position `pos`
+ */
+
+uint32_t MonitorShmRing::LoadLength(uint64_t pos) const {
+  uint32_t len = 0;
+  memcpy(&len, Data() + (pos & (fpHeader->fCapacity - 1)), kLenSize);
+  return len;
+}
+
+} // end namespace cbm
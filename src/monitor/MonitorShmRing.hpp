@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorShmRing
+#define included_Cbm_MonitorShmRing 1
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace cbm {
+using namespace std;
+
+class MonitorShmRing {
+public:
+  struct Stats {
+    uint64_t fNWrite{0};         //!< # of written records
+    uint64_t fNWriteByte{0};     //!< # of written payload bytes
+    uint64_t fNOverwrite{0};     //!< # of records overwritten before read
+    uint64_t fNOverwriteByte{0}; //!< # of payload bytes overwritten
+    uint64_t fNDrop{0};          //!< # of records rejected as too large
+    uint64_t fFill{0};           //!< bytes currently in ring
+    uint64_t fCapacity{0};       //!< size of data area
+    pid_t fWriterPid{0};         //!< pid of writer process
+  };
+
+  MonitorShmRing(const string& name, size_t capacity);
+  explicit MonitorShmRing(const string& name);
+  virtual ~MonitorShmRing();
+
+  MonitorShmRing(const MonitorShmRing&) = delete;
+  MonitorShmRing& operator=(const MonitorShmRing&) = delete;
+
+  const string& Name() const;
+  bool Write(string_view payload);
+  bool Read(string& payload);
+  Stats Statistics() const;
+  bool WriterAlive() const;
+  void Unlink();
+
+  static string ShmName(const string& name);
+
+private:
+  struct Header {
+    atomic<uint64_t> fMagic;            //!< identifies a ring segment
+    uint32_t fVersion;                  //!< layout version
+    uint32_t fPad0;                     //!< padding
+    uint64_t fCapacity;                 //!< size of data area, power of 2
+    int64_t fWriterPid;                 //!< pid of writer process
+    atomic<uint64_t> fNWrite;           //!< # of written records
+    atomic<uint64_t> fNWriteByte;       //!< # of written payload bytes
+    atomic<uint64_t> fNOverwrite;       //!< # of overwritten records
+    atomic<uint64_t> fNOverwriteByte;   //!< # of overwritten payload bytes
+    atomic<uint64_t> fNDrop;            //!< # of rejected records
+    alignas(64) atomic<uint64_t> fHead; //!< write position, writer only
+    alignas(64) atomic<uint64_t> fTail; //!< read position, CAS by both
+  };
+
+  void Map(int fd, size_t size);
+  uint8_t* Data() const;
+  uint32_t LoadLength(uint64_t pos) const;
+
+private:
+  string fName;              //!< shm object name, with leading '/'
+  Header* fpHeader{nullptr}; //!< mapped segment
+  size_t fMapSize{0};        //!< size of mapping
+};
+
+} // end namespace cbm
+
+#include "MonitorShmRing.ipp"
+
+#endif
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the name of the shm object
+
+inline const string& MonitorShmRing::Name() const { return fName; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns pointer to the data area, it follows the header
+
+inline uint8_t* MonitorShmRing::Data() const {
+  return reinterpret_cast<uint8_t*>(fpHeader) + sizeof(Header);
+}
+
+} // end namespace cbm
@@ -20,6 +20,17 @@ using namespace std;
   Concrete implementations are
   - MonitorSinkFile: concrete sink for file output (in InfluxDB line format)
   - MonitorSinkInflux1: concrete sink for InfluxDB V1 output
+  - MonitorSinkInflux2: concrete sink for InfluxDB V2 output
+  - MonitorSinkInfluxShard: concrete sink distributing over several InfluxDBs
+  - MonitorSinkUdp: concrete sink for line format over UDP
+  - MonitorSinkStatsd: concrete sink for StatsD and DogStatsD over UDP
+  - MonitorSinkUnix: concrete sink for line format over a Unix socket
+  - MonitorSinkProm: concrete sink serving a Prometheus scrape endpoint
+  - MonitorSinkShm: concrete sink for a shared memory ring
+  - MonitorSinkAgent: concrete sink for the node-local monitor_agent daemon
+
+  The sink path may carry options as `path?key=value&...`, they are made
+  available to the concrete sinks via `fOptions`, see SinkOptions.
 */
 
 //-----------------------------------------------------------------------------
@@ -29,7 +40,17 @@ using namespace std;
  */
 
 MonitorSink::MonitorSink(Monitor& monitor, const string& path)
-    : fMonitor(monitor), fSinkPath(path) {}
+    : fMonitor(monitor), fSinkPath(path), fOptions(path) {}
+
+//-----------------------------------------------------------------------------
+/*! \brief Set extra tags for the self-monitoring metrics of the sink
+  \param tags  tag set added to the "Monitor" metrics written by the sink
+
+  Used when several sinks of the same type are active, e.g. the shards of
+  a MonitorSinkInfluxShard, to distinguish their self-monitoring data.
+ */
+
+void MonitorSink::SetStatTags(const MetricTagSet& tags) { fStatTags = tags; }
 
 //-----------------------------------------------------------------------------
 /*! \brief Removes protocol characters from a string
@@ -130,4 +151,53 @@ string MonitorSink::InfluxLine(const Metric& point) {
   return res;
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief Return a stable hash of the series key of a Metric `point`
+
+  The series key is the measurement plus the tagset, as used by InfluxDB.
+  The hash is a 64 bit FNV-1a, it does not depend on the platform, compiler
+  or process and can be used to route a series consistently.
+ */
+
+uint64_t MonitorSink::SeriesHash(const Metric& point) {
+  uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+  auto add = [&hash](const string& str, char sep) {
+    for (unsigned char c : str)
+      hash = (hash ^ c) * 1099511628211ULL; // FNV-1a prime
+    hash = (hash ^ (unsigned char)sep) * 1099511628211ULL;
+  };
+  add(point.fMeasurement, ',');
+  for (auto& tag : point.fTagset) {
+    add(tag.first, '=');
+    add(tag.second, ',');
+  }
+  return hash;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Return the value of a numeric or boolean field as `double`
+  \param field  field value
+  \param val    returns the value, `true` as 1 and `false` as 0
+  \returns `false` for string fields, `val` is unchanged then
+
+  Used by sinks for protocols which only support numeric values.
+ */
+
+bool MonitorSink::NumericField(const MetricField& field, double& val) {
+  if (auto pval = get_if<bool>(&field)) {
+    val = *pval ? 1. : 0.;
+  } else if (auto pval = get_if<int>(&field)) {
+    val = double(*pval);
+  } else if (auto pval = get_if<long>(&field)) {
+    val = double(*pval);
+  } else if (auto pval = get_if<unsigned long>(&field)) {
+    val = double(*pval);
+  } else if (auto pval = get_if<double>(&field)) {
+    val = *pval;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 } // end namespace cbm
@@ -6,7 +6,9 @@
 #define included_Cbm_MonitorSink 1
 
 #include "Metric.hpp"
+#include "SinkOptions.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -23,22 +25,28 @@ public:
   virtual void ProcessMetricVec(const vector<Metric>& metvec) = 0;
   virtual void ProcessHeartbeat() = 0;
 
+  void SetStatTags(const MetricTagSet& tags);
+
 protected:
   string CleanString(const string& id);
   string EscapeString(const string& str);
   string InfluxTags(const Metric& point);
   string InfluxFields(const Metric& point);
   string InfluxLine(const Metric& point);
+  uint64_t SeriesHash(const Metric& point);
+  static bool NumericField(const MetricField& field, double& val);
 
 protected:
-  Monitor& fMonitor;       //!< back reference to Monitor
-  string fSinkPath;        //!< path for output
-  long fStatNPoint{0};     //!< # of processed points
-  long fStatNTag{0};       //!< # of processed tags
-  long fStatNField{0};     //!< # of processed fields
-  long fStatNSend{0};      //!< # of send requests
-  long fStatNByte{0};      //!< # of send bytes
-  double fStatSndTime{0.}; //!< time spend in send requests
+  Monitor& fMonitor;        //!< back reference to Monitor
+  string fSinkPath;         //!< path for output
+  SinkOptions fOptions;     //!< path and options split from fSinkPath
+  long fStatNPoint{0};      //!< # of processed points
+  long fStatNTag{0};        //!< # of processed tags
+  long fStatNField{0};      //!< # of processed fields
+  long fStatNSend{0};       //!< # of send requests
+  long fStatNByte{0};       //!< # of send bytes
+  double fStatSndTime{0.};  //!< time spend in send requests
+  MetricTagSet fStatTags{}; //!< extra tags for self-monitoring metrics
 };
 
 } // end namespace cbm
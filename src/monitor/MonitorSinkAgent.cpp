@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkAgent.hpp"
+
+#include "Exception.hpp"
+#include "MetricCodec.hpp"
+
+#include "fmt/format.h"
+
+#include <cstring>
+
+#include <sys/socket.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const size_t kLenSize = sizeof(uint32_t); // size of frame length word
+
+/*! \class MonitorSinkAgent
+  \brief Monitor sink - concrete sink for the node-local `monitor_agent`
+
+  Sends the metrics in the compact binary encoding of MetricEncode() over a
+  Unix stream socket to the `monitor_agent` daemon. The daemon collects the
+  metrics of all processes on a node, optionally aggregates them, and
+  forwards them in large batches over a few persistent connections. This
+  avoids that each process keeps its own connections to the database.
+
+  Each chunk is a frame: a 32 bit length word in host byte order followed
+  by the encoded metrics. A batch is split into several frames when needed
+  to keep frames within the `chunk` size; a single metric larger than
+  `chunk` is still sent in its own frame. Connection handling, buffering
+  and the options are provided by MonitorSinkUnix, except that only
+  `type=stream` is supported. After a connection loss a partially sent
+  frame is resent completely, the daemon discards incomplete frames.
+
+  In addition to the MonitorSinkUnix fields the self-monitoring Metric has
+  - `frames`: number of queued frames in last period
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    path of the agent socket, options may follow
+  \throws Exception if `path` is empty or an option is invalid
+
+  The socket path can be followed by `?` and the MonitorSinkUnix options.
+ */
+
+MonitorSinkAgent::MonitorSinkAgent(Monitor& monitor, const string& path)
+    : MonitorSinkUnix(monitor, path, "MonitorSinkAgent", {}) {
+  if (fSockType != SOCK_STREAM)
+    throw Exception(fmt::format("MonitorSinkAgent::ctor: only type=stream"
+                                " supported in '{}'",
+                                path));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+ */
+
+void MonitorSinkAgent::ProcessMetricVec(const vector<Metric>& metvec) {
+  fStatNPoint += metvec.size();
+  for (auto& met : metvec) {
+    fStatNTag += met.fTagset.size();
+    fStatNField += met.fFieldset.size();
+  }
+  if (!metvec.empty())
+    QueueFrames(metvec, 0, metvec.size());
+  Flush();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Encode metrics `[ibeg,iend)` in frames and queue them
+
+  The range is encoded in one frame, when that exceeds the `chunk` size it
+  is split in halves, which are encoded recursively.
+ */
+
+void MonitorSinkAgent::QueueFrames(const vector<Metric>& metvec,
+                                   size_t ibeg,
+                                   size_t iend) {
+  string frame(kLenSize, '\0');
+  MetricEncode(metvec, ibeg, iend, frame);
+  if (frame.size() > fChunkSize && iend - ibeg > 1) {
+    size_t imid = ibeg + (iend - ibeg) / 2;
+    QueueFrames(metvec, ibeg, imid);
+    QueueFrames(metvec, imid, iend);
+    return;
+  }
+  uint32_t len = uint32_t(frame.size() - kLenSize);
+  memcpy(frame.data(), &len, kLenSize);
+  fStatNFrame += 1;
+  QueueChunk(move(frame));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Partially sent frames are resent completely
+ */
+
+size_t MonitorSinkAgent::ResendTrim(const string&, size_t) { return 0; }
+
+//-----------------------------------------------------------------------------
+/*! \brief Add agent specific fields to the self-monitoring metric
+ */
+
+void MonitorSinkAgent::AddStatFields(MetricFieldSet& fields) {
+  fields.emplace_back("frames", fStatNFrame);
+  fStatNFrame = 0;
+}
+
+} // end namespace cbm
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkAgent
+#define included_Cbm_MonitorSinkAgent 1
+
+#include "MonitorSinkUnix.hpp"
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkAgent : public MonitorSinkUnix {
+public:
+  MonitorSinkAgent(Monitor& monitor, const string& path);
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+
+private:
+  void QueueFrames(const vector<Metric>& metvec, size_t ibeg, size_t iend);
+  virtual size_t ResendTrim(const string& chunk, size_t nsent);
+  virtual void AddStatFields(MetricFieldSet& fields);
+
+private:
+  long fStatNFrame{0}; //!< # of queued frames
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkAgent.ipp"
+
+#endif
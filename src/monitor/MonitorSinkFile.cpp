@@ -4,27 +4,65 @@
 
 #include "MonitorSinkFile.hpp"
 
+#include "ChronoHelper.hpp"
 #include "Exception.hpp"
 #include "Monitor.hpp"
+#include "SysCallException.hpp"
 
 #include "fmt/format.h"
 
-#include <fstream>
+#include <iostream>
 
 namespace cbm {
 using namespace std;
+// some constants
+static const size_t kBufSize = 1000000; // default write buffer size
 
 /*! \class MonitorSinkFile
   \brief Monitor sink - concrete sink for file output
+
+  Writes the metrics in InfluxDB line format. The lines are collected in a
+  user-space buffer and written with few `writev(2)` calls, see FileWriter.
+  When the buffered data is written is controlled by the `sync` option.
+
+  The sink writes periodically some self-monitoring data as Metric to
+  measurement "Monitor" with the fields
+  - `points`: number of metrics in last period
+  - `tags`: total number of tags in all metrics in last period
+  - `fields`: total number of fields in all metrics in last period
+  - `writes`: number of write system calls in last period
+  - `bytes`: total number bytes written in last period
+  - `wrtime`: total elapsed time spend in write calls (in s)
+  - `wrmax`: longest write call in last period (in s)
+  - `syncs`: number of `fdatasync(2)` calls in last period
+  - `synctime`: total elapsed time spend in `fdatasync(2)` (in s)
+  - `rotations`: number of file rotations in last period
+
+  The Metric is tagged with the tags set with SetStatTags().
 */
 
 //-----------------------------------------------------------------------------
 /*! \brief Constructor
   \param monitor back reference to Monitor
-  \param path   filename
+  \param path   filename, options may follow
+  \throws Exception if an option is invalid
+  \throws SysCallException if the file can't be opened
 
   Write metrics to a file named `path`. The special names `cout` and `cerr`
-  will open these standard streams, in all other cases a file will be opened.
+  will write to these standard streams, in all other cases a file will be
+  opened.
+
+  The file name can be followed by `?` and these options
+  - `bufsize`: size of the write buffer in bytes (default '1M')
+  - `sync`: durability policy
+    - `none`: data is written when the buffer is full, at each heartbeat
+      and when the sink is closed
+    - `batch`: data is written after each batch of metrics (default)
+    - a number: like `batch`, and in addition `fdatasync(2)` is called
+      every `sync` seconds, so at most that period is lost on a crash
+  - `io`, `iodepth`: output backend, see FileWriter::Configure()
+  - `rotsize`, `rotint`, `keep`, `compress`: file rotation, see
+    FileWriter::Configure()
 
   Several MonitorSinkFile sinks with different `path` can be opened
   simultaneously and will receive the same data.
@@ -32,17 +70,27 @@ using namespace std;
 
 MonitorSinkFile::MonitorSinkFile(Monitor& monitor, const string& path)
     : MonitorSink(monitor, path) {
-  if (path == "cout"s) {
-    fpCout = &cout;
-  } else if (path == "cerr"s) {
-    fpCout = &cerr;
+  vector<string> keys = FileWriter::kOptionKeys;
+  keys.insert(keys.end(), {"bufsize", "sync"});
+  fOptions.Check("MonitorSinkFile::ctor", keys);
+  string ssync = fOptions.String("sync", "batch");
+  if (ssync == "none") {
+    fSyncMode = kSyncNone;
+  } else if (ssync == "batch") {
+    fSyncMode = kSyncBatch;
   } else {
-    fpOStream = make_unique<ofstream>(path);
-    if (!fpOStream->is_open())
-      throw Exception(fmt::format("MonitorSinkFile::ctor: open()"
-                                  " failed for '{}'",
+    fSyncMode = kSyncData;
+    fSyncPeriod = fOptions.Double("sync", 0.);
+    if (fSyncPeriod <= 0.)
+      throw Exception(fmt::format("MonitorSinkFile::ctor: sync must be none,"
+                                  " batch or a positive period in '{}'",
                                   path));
+    fNextSync = ScNow() + chrono::duration_cast<scduration>(
+                              chrono::duration<double>(fSyncPeriod));
   }
+  fpWriter = make_unique<FileWriter>(fOptions.Path(),
+                                     fOptions.Size("bufsize", kBufSize));
+  fpWriter->Configure(fOptions);
 }
 
 //-----------------------------------------------------------------------------
@@ -50,17 +98,79 @@ MonitorSinkFile::MonitorSinkFile(Monitor& monitor, const string& path)
  */
 
 void MonitorSinkFile::ProcessMetricVec(const vector<Metric>& metvec) {
-  ostream& os = fpCout ? *fpCout : *fpOStream;
-  for (auto& met : metvec)
-    os << InfluxLine(met) << "\n";
+  fStatNPoint += metvec.size();
+  try {
+    for (auto& met : metvec) {
+      fStatNTag += met.fTagset.size();
+      fStatNField += met.fFieldset.size();
+      fpWriter->Write(InfluxLine(met) + "\n"s);
+    }
+  } catch (const SysCallException& e) {
+    WriteError(e);
+  }
   if (size(metvec) > 0)
-    os.flush();
+    Commit(false);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat
+
+  Writes the buffered data, then queues the self-monitoring metric.
+ */
+
+void MonitorSinkFile::ProcessHeartbeat() {
+  Commit(true);
+  auto stats = fpWriter->Statistics();
+  fpWriter->ResetStatistics();
+  MetricFieldSet fields = {{"points", fStatNPoint}, // fields
+                           {"tags", fStatNTag},
+                           {"fields", fStatNField},
+                           {"writes", stats.fNWrite},
+                           {"bytes", stats.fNByte},
+                           {"wrtime", stats.fWriteTime},
+                           {"wrmax", stats.fWriteMax},
+                           {"syncs", stats.fNSync},
+                           {"synctime", stats.fSyncTime},
+                           {"rotations", stats.fNRotate}};
+  Monitor::Ref().QueueMetric("Monitor", // measurement
+                             fStatTags, // extra tags
+                             move(fields));
+  fStatNPoint = 0;
+  fStatNTag = 0;
+  fStatNField = 0;
 }
 
 //-----------------------------------------------------------------------------
-/*! \brief Process heartbeat (noop for file sink)
+/*! \brief Write buffered data as demanded by the `sync` policy
+  \param heartbeat  `true` when called from the heartbeat, always writes
  */
 
-void MonitorSinkFile::ProcessHeartbeat() {}
+void MonitorSinkFile::Commit(bool heartbeat) {
+  try {
+    if (fSyncMode == kSyncData && ScNow() >= fNextSync) {
+      fpWriter->Sync();
+      fNextSync = ScNow() + chrono::duration_cast<scduration>(
+                                chrono::duration<double>(fSyncPeriod));
+    } else if (heartbeat || fSyncMode != kSyncNone) {
+      fpWriter->Flush();
+    }
+  } catch (const SysCallException& e) {
+    WriteError(e);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Report a write error, the affected data is lost
+ */
+
+void MonitorSinkFile::WriteError(const SysCallException& e) {
+#if defined(CBMLOGERR1)
+  CBMLOGERR1("cid=__Monitor", "SendData-err")
+      << "sinkname=" << fSinkPath << ", error=" << e.what();
+#else
+  std::cerr << "MonitorSinkFile::Write error: "
+            << "sinkname=" << fSinkPath << ", error=" << e.what() << "\n";
+#endif
+}
 
 } // end namespace cbm
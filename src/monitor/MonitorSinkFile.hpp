@@ -5,10 +5,11 @@
 #ifndef included_Cbm_MonitorSinkFile
 #define included_Cbm_MonitorSinkFile 1
 
+#include "ChronoDefs.hpp"
+#include "FileWriter.hpp"
 #include "MonitorSink.hpp"
+#include "SysCallException.hpp"
 
-#include <fstream>
-#include <iostream>
 #include <memory>
 
 namespace cbm {
@@ -22,8 +23,20 @@ public:
   virtual void ProcessHeartbeat();
 
 private:
-  ostream* fpCout{nullptr};         //!< pointer to cout/cerr
-  unique_ptr<ofstream> fpOStream{}; //!< uptr to general output stream
+  enum SyncMode {
+    kSyncNone = 0, //!< write only when the buffer is full
+    kSyncBatch,    //!< write after each batch
+    kSyncData      //!< write after each batch, fdatasync periodically
+  };
+
+  void Commit(bool heartbeat);
+  void WriteError(const SysCallException& e);
+
+private:
+  unique_ptr<FileWriter> fpWriter{}; //!< buffered file writer
+  SyncMode fSyncMode{kSyncBatch};    //!< durability policy
+  double fSyncPeriod{0.};            //!< fdatasync period (in s)
+  sctime_point fNextSync{};          //!< time of next fdatasync
 };
 
 } // end namespace cbm
@@ -0,0 +1,702 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkInflux.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "Monitor.hpp"
+#include "PThreadHelper.hpp"
+
+#include "fmt/format.h"
+
+// define needed for Boost 1.67 in Debian Buster to avoid a missing
+// boost::system::system_category() symbol. That's apparently default since
+// Boost 1.69, so Boost 1.71 (Ub focal) and 1.74 (Debian Bullseye work fine
+// without. See https://stackoverflow.com/questions/9723793/
+#define BOOST_ERROR_CODE_HEADER_ONLY
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/version.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+#include <zlib.h>
+
+namespace cbm {
+using namespace std;
+using tcp = boost::asio::ip::tcp;    // from <boost/asio/ip/tcp.hpp>
+namespace http = boost::beast::http; // from <boost/beast/http.hpp>
+// some constants
+static const size_t kSendChunkSize = 2000000; // initial send chunk size
+static const size_t kSendChunkMin = 100000;   // default lower bound
+static const size_t kSendChunkMax = 20000000; // default upper bound
+static const double kSendTimeout = 10.;       // default send timeout
+static const double kSendTarget = 1.;         // default send target time
+static const double kChunkGrowFactor = 1.25;  // growth step on fast sends
+static const int kGzipLevel = 1;              // fast, metrics compress well
+
+// lane hash: SeriesHash() mixed again (murmur3 finalizer), so that the lane
+// is independent of the shard choice of MonitorSinkInfluxShard
+static inline uint64_t RemixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+//! \brief A persistent HTTP connection, see the `keepalive` option
+struct MonitorSinkInflux::Conn {
+  boost::asio::io_context fIoc{};      //!< context for all I/O
+  tcp::socket fSocket{fIoc};           //!< connected socket
+  boost::beast::flat_buffer fBuffer{}; //!< read buffer, must persist
+  string fHost{};                      //!< host the socket is connected to
+};
+
+/*! \class MonitorSinkInflux
+  \brief Monitor sink - common base for InfluxDB sinks
+
+  Implements the transfer of metrics in line format via HTTP POST requests,
+  the concrete sinks MonitorSinkInflux1 and MonitorSinkInflux2 only setup
+  the server endpoint, the HTTP target and the extra HTTP header fields.
+
+  The metrics are sent in chunks. The chunk size is adapted automatically
+  within configurable bounds based on the observed round-trip time and the
+  server responses:
+  - a send taking longer than the target time shrinks the chunk size
+    proportionally, by at most a factor of two
+  - a full chunk sent in less than half the target time grows the chunk
+    size by 25%
+  - a `413 Payload Too Large` response halves the chunk size, the rejected
+    chunk is split and sent again
+  - a `429`, a `5xx` response or a timeout halves the chunk size
+
+  The adaption is controlled by sink options (see SinkOptions)
+  - `chunk`: initial chunk size in bytes (default '2M')
+  - `chunkmin`: lower bound of chunk size (default '100k')
+  - `chunkmax`: upper bound of chunk size (default '20M')
+  - `timeout`: timeout for one send request in s (default '10')
+  - `target`: target time for one send request in s (default '1')
+
+  By default all send requests are done sequentially by the Monitor worker
+  thread. With the `parallel` option the chunks are sent concurrently over
+  several connections:
+  - `parallel`: number of send lanes, each with its own thread (default '1')
+  - `inflight`: limit for the total size of all queued and in-flight chunks
+    (default `parallel` times `chunkmax`)
+
+  Each point is routed to a lane by a hash of its series key (see
+  MonitorSink::SeriesHash()), so all points of a series are sent in order
+  over the same lane. The hash is mixed again before the lane is chosen,
+  which keeps the lane independent of the shard in MonitorSinkInfluxShard.
+  When the inflight limit is reached, the Monitor worker thread waits until
+  enough chunks have been sent.
+
+  The transfer can be made more efficient with the options
+  - `gzip`: sends the body gzip compressed with `Content-Encoding: gzip`,
+    line format typically compresses by a factor 5 to 10
+  - `keepalive`: keeps the connections open and reuses them for the next
+    requests, saving the TCP handshake per request. At most one idle
+    connection per lane is kept. When a reused connection was closed by the
+    server meanwhile, the request is retried once over a new connection
+
+  The host part of the endpoint can be a comma separated list of a primary
+  server and replicas, e.g. `influx-a,influx-b`. When a server can't be
+  reached the sink fails over to the next one in the list and resends the
+  chunk there. All servers must use the same port and database or bucket.
+
+  The sink writes periodically some self-monitoring data as Metric to
+  measurement "Monitor" with the fields
+  - `points`: number of metrics in last period
+  - `tags`: total number of tags in all metrics in last period
+  - `fields`: total number of fields in all metrics in last period
+  - `sends`: number of HTTP post requests in last period
+  - `bytes`: total number bytes written in last period
+  - `sndtime`: total elapsed time spend in HTTP post requests (in s)
+  - `chunksize`: current send chunk size
+  - `failovers`: number of switches to the next replica in last period
+  - `inflight`: bytes queued or in send in the lanes (only with `parallel`)
+  - `connects`: number of new connections in last period
+
+  The Metric is tagged with the tags set with SetStatTags().
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    write endpoint with options
+  \param cname   class name of concrete sink, used in messages
+  \throws Exception if an unknown option is given or the chunk size bounds
+    are inconsistent
+
+  When the `parallel` option is given the lane threads are started here.
+  They are idle until the first chunk is queued and only access the
+  endpoint definition setup by the constructor of the concrete sink then.
+ */
+
+MonitorSinkInflux::MonitorSinkInflux(Monitor& monitor,
+                                     const string& path,
+                                     const string& cname)
+    : MonitorSink(monitor, path), fClassName(cname) {
+  fOptions.Check(fClassName + "::ctor", {"chunk", "chunkmin", "chunkmax",
+                                         "timeout", "target", "parallel",
+                                         "inflight", "gzip", "keepalive"});
+  fChunkMin = fOptions.Size("chunkmin", kSendChunkMin);
+  fChunkMax = fOptions.Size("chunkmax", kSendChunkMax);
+  fChunkSize = fOptions.Size("chunk", kSendChunkSize);
+  fSendTimeout = fOptions.Double("timeout", kSendTimeout);
+  fSendTarget = fOptions.Double("target", kSendTarget);
+  if (fChunkMin == 0 || fChunkMin > fChunkMax)
+    throw Exception(fmt::format("{}::ctor: invalid chunk size bounds"
+                                " [{},{}] in '{}'",
+                                fClassName, fChunkMin, fChunkMax, path));
+  if (fSendTimeout <= 0. || fSendTarget <= 0.)
+    throw Exception(fmt::format("{}::ctor: timeout and target must be"
+                                " positive in '{}'",
+                                fClassName, path));
+  fChunkSize = clamp(fChunkSize.load(), fChunkMin, fChunkMax);
+  fGzip = fOptions.Bool("gzip", false);
+  fKeepAlive = fOptions.Bool("keepalive", false);
+
+  long nlane = fOptions.Long("parallel", 1);
+  if (nlane < 1)
+    throw Exception(fmt::format("{}::ctor: parallel must be >= 1 in '{}'",
+                                fClassName, path));
+  fInflightMax = fOptions.Size("inflight", size_t(nlane) * fChunkMax);
+  if (nlane > 1)
+    StartLanes(size_t(nlane));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor
+
+  Stops the send lanes, all still queued chunks are sent before.
+ */
+
+MonitorSinkInflux::~MonitorSinkInflux() { StopLanes(); }
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+ */
+
+void MonitorSinkInflux::ProcessMetricVec(const vector<Metric>& metvec) {
+  vector<const Metric*> metptrs;
+  metptrs.reserve(metvec.size());
+  for (auto& met : metvec)
+    metptrs.push_back(&met);
+  ProcessMetricPtrVec(metptrs);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of pointers to metrics
+
+  Allows a sink which distributes metrics over several MonitorSinkInflux
+  sinks, like MonitorSinkInfluxShard, to pass subsets without copying.
+ */
+
+void MonitorSinkInflux::ProcessMetricPtrVec(
+    const vector<const Metric*>& metvec) {
+  {
+    lock_guard<mutex> lock(fStatMutex);
+    fStatNPoint += metvec.size();
+    for (auto pmet : metvec) {
+      fStatNTag += pmet->fTagset.size();
+      fStatNField += pmet->fFieldset.size();
+    }
+  }
+
+  if (fLanes.empty()) { // serial mode, send from Monitor thread
+    string msg;
+    for (auto pmet : metvec) {
+      msg += InfluxLine(*pmet) + "\n"s;
+      if (msg.size() > fChunkSize) { // limit send chunk size
+        SendChunk(msg);
+        msg.clear();
+      }
+    }
+    if (msg.size() > 0)
+      SendChunk(msg);
+    return;
+  }
+
+  // parallel mode, distribute series over lanes
+  size_t nlane = fLanes.size();
+  vector<string> msgs(nlane);
+  for (auto pmet : metvec) {
+    size_t ilane = size_t(RemixHash(SeriesHash(*pmet)) % nlane);
+    string& msg = msgs[ilane];
+    msg += InfluxLine(*pmet) + "\n"s;
+    if (msg.size() > fChunkSize) { // limit send chunk size
+      QueueChunk(ilane, move(msg));
+      msg.clear();
+    }
+  }
+  for (size_t ilane = 0; ilane < nlane; ilane++)
+    if (msgs[ilane].size() > 0)
+      QueueChunk(ilane, move(msgs[ilane]));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat
+ */
+
+void MonitorSinkInflux::ProcessHeartbeat() {
+  lock_guard<mutex> lock(fStatMutex);
+  MetricFieldSet fields = {{"points", fStatNPoint}, // fields
+                           {"tags", fStatNTag},
+                           {"fields", fStatNField},
+                           {"sends", fStatNSend},
+                           {"bytes", fStatNByte},
+                           {"sndtime", fStatSndTime}, // 'time' not allowed
+                           {"chunksize", fChunkSize.load()},
+                           {"failovers", fStatNFailover},
+                           {"connects", fStatNConnect}};
+  if (!fLanes.empty()) {
+    lock_guard<mutex> lock(fLaneMutex);
+    fields.emplace_back("inflight", fInflight);
+  }
+  Monitor::Ref().QueueMetric("Monitor", // measurement
+                             fStatTags, // extra tags
+                             move(fields));
+  fStatNPoint = 0;
+  fStatNTag = 0;
+  fStatNField = 0;
+  fStatNSend = 0;
+  fStatNByte = 0;
+  fStatSndTime = 0.;
+  fStatNFailover = 0;
+  fStatNConnect = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Setup server endpoint
+  \param hosts  host name, or comma separated list of primary and replicas
+  \param port   port number
+  \throws Exception if `hosts` contains an empty host name
+ */
+
+void MonitorSinkInflux::SetEndpoint(const string& hosts, const string& port) {
+  size_t pbeg = 0;
+  while (true) {
+    size_t pend = hosts.find(',', pbeg);
+    string host = hosts.substr(pbeg, pend - pbeg);
+    if (host.empty())
+      throw Exception(fmt::format("{}::SetEndpoint: empty host name in '{}'",
+                                  fClassName, hosts));
+    fHosts.push_back(host);
+    if (pend == string::npos)
+      break;
+    pbeg = pend + 1;
+  }
+  fPort = port;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Start `nlane` send lanes, each with its own thread
+ */
+
+void MonitorSinkInflux::StartLanes(size_t nlane) {
+  for (size_t i = 0; i < nlane; i++)
+    fLanes.push_back(make_unique<Lane>());
+  for (size_t i = 0; i < nlane; i++)
+    fLanes[i]->fThread = thread([this, i]() { LaneLoop(i); });
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Stop all send lanes after all queued chunks were sent
+ */
+
+void MonitorSinkInflux::StopLanes() {
+  {
+    lock_guard<mutex> lock(fLaneMutex);
+    fLaneStop = true;
+  }
+  fLaneCond.notify_all();
+  for (auto& lane : fLanes)
+    if (lane->fThread.joinable())
+      lane->fThread.join();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Queue a chunk for send in a lane
+  \param ilane  lane index
+  \param msg    set of points in line format (will be moved)
+
+  Waits until the chunk fits into the inflight limit. A chunk is always
+  accepted when nothing is in flight, so a single chunk larger than the
+  limit can't block the sink.
+ */
+
+void MonitorSinkInflux::QueueChunk(size_t ilane, string&& msg) {
+  {
+    unique_lock<mutex> lock(fLaneMutex);
+    fSpaceCond.wait(lock, [this, &msg]() {
+      return fInflight == 0 || fInflight + msg.size() <= fInflightMax;
+    });
+    fInflight += msg.size();
+    fLanes[ilane]->fQueue.push_back(move(msg));
+  }
+  fLaneCond.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief The send loop of a lane thread
+  \param ilane  lane index
+ */
+
+void MonitorSinkInflux::LaneLoop(size_t ilane) {
+  SetPThreadName(fmt::format("Cbm:monsend{}", ilane));
+  Lane& lane = *fLanes[ilane];
+
+  while (true) {
+    string msg;
+    {
+      unique_lock<mutex> lock(fLaneMutex);
+      fLaneCond.wait(lock, [this, &lane]() {
+        return fLaneStop || !lane.fQueue.empty();
+      });
+      if (lane.fQueue.empty()) // only when stopped and all sent
+        break;
+      msg = move(lane.fQueue.front());
+      lane.fQueue.pop_front();
+    }
+
+    SendChunk(msg);
+
+    {
+      lock_guard<mutex> lock(fLaneMutex);
+      fInflight -= msg.size();
+    }
+    fSpaceCond.notify_all();
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Send a chunk, fail over or split and resend it when needed
+  \param msg   set of points in line format
+
+  When the active server is not reachable the next replica becomes the
+  active server and the chunk is sent again, until all servers were tried.
+
+  A chunk rejected with `413 Payload Too Large` is split at the line boundary
+  closest to its middle and both halves are sent again. Splitting stops when
+  the chunk is not larger than the lower chunk size bound.
+ */
+
+void MonitorSinkInflux::SendChunk(const string& msg) {
+  double rtt = 0.;
+  auto stat = SendData(msg, rtt);
+  for (size_t itry = 1; stat == kSendNoConn && itry < fHosts.size(); itry++) {
+    fHostIndex = (fHostIndex + 1) % fHosts.size();
+    {
+      lock_guard<mutex> lock(fStatMutex);
+      fStatNFailover += 1;
+    }
+    stat = SendData(msg, rtt);
+  }
+  AdaptChunkSize(msg.size(), stat, rtt);
+  if (stat != kSendTooLarge || msg.size() <= fChunkMin)
+    return;
+
+  size_t pos = msg.find('\n', msg.size() / 2);
+  if (pos == string::npos || pos + 1 >= msg.size())
+    pos = msg.rfind('\n', msg.size() / 2);
+  if (pos == string::npos)
+    return; // single line, can't split
+  SendChunk(msg.substr(0, pos + 1));
+  SendChunk(msg.substr(pos + 1));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Send a set of points in line format to database
+  \param msg   set of points in line format
+  \param rtt   returns the round-trip time of the request (in s)
+  \param retry if `true`, a request on a stale connection is sent again
+  \returns status of the send, used for chunk size adaption
+
+  The whole request, from connect to the reception of the response, must
+  complete within the `timeout` given as sink option.
+
+  With the `keepalive` option an idle connection to the active host is
+  taken from the pool and returned after a successful request. When a
+  reused connection turns out to be closed by the server while it was idle,
+  the request is sent once more, over the next idle or a new connection.
+  The connection is only considered closed when writing the request fails
+  with `eof`, `connection_reset` or `broken_pipe`, or when the end of stream
+  is seen before any byte of the response. After any other error, and in
+  particular after a timeout, the server may have applied the write, so the
+  request is not sent again.
+ */
+
+MonitorSinkInflux::SendStatus MonitorSinkInflux::SendData(const string& msg,
+                                                          double& rtt,
+                                                          bool retry) {
+  SendStatus stat = kSendOK;
+  bool connected = false;
+  bool reused = false;
+  bool stale = false;
+  const string& host = fHosts[fHostIndex % fHosts.size()];
+  unique_ptr<Conn> conn;
+  if (fKeepAlive) {
+    lock_guard<mutex> lock(fConnMutex);
+    while (!fConnPool.empty() && !conn) {
+      if (fConnPool.back()->fHost == host) // drop connections to old hosts
+        conn = move(fConnPool.back());
+      fConnPool.pop_back();
+    }
+  }
+  if (conn) {
+    reused = true;
+    connected = true;
+  } else {
+    conn = make_unique<Conn>();
+    conn->fHost = host;
+  }
+
+  try {
+    // start timer
+    auto tbeg = ScNow();
+    auto tend = chrono::steady_clock::now() +
+                chrono::duration_cast<chrono::steady_clock::duration>(
+                    chrono::duration<double>(fSendTimeout));
+
+    // The io_context is required for all I/O
+    boost::asio::io_context& ioc = conn->fIoc;
+
+    // These objects perform our I/O
+    tcp::socket& socket = conn->fSocket;
+
+    // Run pending asynchronous operation, enforce the overall timeout
+    boost::system::error_code ec;
+    bool done = false;
+    auto run = [&ioc, &socket, &ec, &done, tend]() {
+      ioc.restart();
+      ioc.run_until(tend);
+      if (!done) { // timeout, abort operation
+        socket.close();
+        throw boost::system::system_error{boost::asio::error::timed_out};
+      }
+      if (ec)
+        throw boost::system::system_error{ec};
+      done = false;
+    };
+
+    if (!connected) {
+      // Look up the domain name
+      tcp::resolver resolver{ioc};
+      auto const results = resolver.resolve(host, fPort);
+
+      // Make the connection on the IP address we get from a lookup
+      boost::asio::async_connect(
+          socket, results.begin(), results.end(),
+          [&ec, &done](boost::system::error_code e, auto) {
+            ec = e;
+            done = true;
+          });
+      run();
+      connected = true;
+      lock_guard<mutex> lock(fStatMutex);
+      fStatNConnect += 1;
+    }
+
+    // Set up an HTTP POST request message
+    int version = 11;
+    http::request<http::string_body> req{http::verb::post, fTarget, version};
+    req.set(http::field::host, host);
+    for (auto& field : fHttpFields)
+      req.set(field.first, field.second);
+    if (fGzip) {
+      req.set(http::field::content_encoding, "gzip");
+      req.body() = Gzip(msg);
+    } else {
+      req.body() = msg;
+    }
+    req.set(http::field::content_length, to_string(req.body().size()));
+
+    // Send the HTTP request to the remote host
+    http::async_write(
+        socket, req, [&ec, &done, &stale](boost::system::error_code e, size_t) {
+          ec = e;
+          done = true;
+          stale = e == boost::asio::error::eof ||
+                  e == boost::asio::error::connection_reset ||
+                  e == boost::asio::error::broken_pipe;
+        });
+    run();
+
+    // Declare a container to hold the response
+    http::response<http::string_body> res;
+
+    // Receive the HTTP response
+    http::async_read(
+        socket, conn->fBuffer, res,
+        [&ec, &done, &stale](boost::system::error_code e, size_t nbyte) {
+          ec = e;
+          done = true;
+          stale = nbyte == 0 && (e == http::error::end_of_stream ||
+                                 e == boost::asio::error::eof);
+        });
+    run();
+    rtt = ScTimeDiff2Double(tbeg, ScNow());
+
+    // Check response
+    // Note on boost::beast::http::response:
+    //   result() does not return the HTTP status, one gets the reason phrase as
+    //   it is also returned by reason(). result_int() return the status as int.
+    // Note on InfluxDB:
+    //   returns a 204 -> "No Content" for successful completion
+    //   returns a 404 -> "Not Found" if data base not existing
+    //   returns a 400 -> "Bad request" if request is ill-formed (V1)
+    //   returns a 422 -> "Unprocessable entity" if request is ill-formed (V2)
+    //   returns a 413 -> "Request Entity Too Large" if body too large
+    //   returns a 429 or 503 if overloaded
+    unsigned status = res.result_int();
+    if (status != 200 && status != 204) { // allow 200 & 204
+      if (status == 413)
+        stat = kSendTooLarge;
+      else if (status == 429 || status >= 500)
+        stat = kSendOverload;
+      else
+        stat = kSendFailed;
+
+      string efields = "";
+      for (auto const& field : res) {
+        efields += string(field.name_string());       // C++17 string_view
+        efields += "=" + string(field.value()) + ";"; // limitation, grrr
+      }
+      string ebody = res.body(); // get body, trim \r and trailing \n
+      ebody.erase(std::remove(ebody.begin(), ebody.end(), '\r'), ebody.end());
+      if (!ebody.empty() && ebody[ebody.size() - 1] == '\n')
+        ebody.erase(ebody.size() - 1);
+
+#if defined(CBMLOGERR1)
+      CBMLOGERR1("cid=__Monitor", "SendData-err")
+          << "sinkname=" << fSinkPath << ", HTTP status=" << status << " "
+          << res.reason() << ", HTTP fields=" << efields
+          << ", HTTP body=" << ebody;
+#else
+      std::cerr << fClassName << "::SendData error: "
+                << "sinkname=" << fSinkPath << ", HTTP status=" << status
+                << " " << res.reason() << ", HTTP fields=" << efields
+                << ", HTTP body=" << ebody << "\n";
+#endif
+    }
+
+    // do stats
+    {
+      lock_guard<mutex> lock(fStatMutex);
+      fStatNSend += 1;
+      fStatNByte += req.body().size();
+      fStatSndTime += rtt;
+    }
+
+    // Keep the connection when the server agrees, at most one per lane
+    if (fKeepAlive && res.keep_alive()) {
+      lock_guard<mutex> lock(fConnMutex);
+      if (fConnPool.size() < max(fLanes.size(), size_t(1))) {
+        fConnPool.push_back(move(conn));
+        return stat;
+      }
+    }
+
+    // Gracefully close the socket
+    socket.shutdown(tcp::socket::shutdown_both, ec);
+
+    // not_connected happens sometimes
+    // so don't bother reporting it.
+    //
+    if (ec && ec != boost::system::errc::not_connected)
+      throw boost::system::system_error{ec};
+
+    // If we get here then the connection is closed gracefully
+  } catch (boost::system::system_error const& e) {
+    if (reused && stale && retry) // closed by server while idle, retry
+      return SendData(msg, rtt, false);
+    if (!connected)
+      stat = kSendNoConn;
+    else if (e.code() == boost::asio::error::timed_out)
+      stat = kSendOverload;
+    else if (stat == kSendOK)
+      stat = kSendFailed;
+#if defined(CBMLOGERR1)
+    CBMLOGERR1("cid=__Monitor", "SendData-err")
+        << "sinkname=" << fSinkPath << ", error=" << e.what();
+#else
+    std::cerr << fClassName << "::SendData error: "
+              << "sinkname=" << fSinkPath << ", error=" << e.what() << "\n";
+#endif
+  } catch (exception const& e) {
+    stat = connected ? kSendFailed : kSendNoConn;
+#if defined(CBMLOGERR1)
+    CBMLOGERR1("cid=__Monitor", "SendData-err")
+        << "sinkname=" << fSinkPath << ", error=" << e.what();
+#else
+    std::cerr << fClassName << "::SendData error: "
+              << "sinkname=" << fSinkPath << ", error=" << e.what() << "\n";
+#endif
+  }
+  return stat;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Adapt send chunk size after a send
+  \param nbyte  size of the chunk sent
+  \param stat   status of the send
+  \param rtt    round-trip time of the send (in s)
+ */
+
+void MonitorSinkInflux::AdaptChunkSize(size_t nbyte,
+                                       SendStatus stat,
+                                       double rtt) {
+  lock_guard<mutex> lock(fStatMutex);
+  double size = double(fChunkSize);
+  switch (stat) {
+  case kSendOK:
+    if (rtt > fSendTarget) { // too slow, shrink proportionally
+      size = min(size, double(nbyte)) * max(0.5, fSendTarget / rtt);
+    } else if (rtt < 0.5 * fSendTarget && 10 * nbyte >= 9 * fChunkSize) {
+      size *= kChunkGrowFactor; // full chunk and fast, grow
+    }
+    break;
+  case kSendTooLarge:
+    size = 0.5 * min(size, double(nbyte));
+    break;
+  case kSendOverload:
+    size *= 0.5;
+    break;
+  case kSendNoConn: // unrelated to size, keep
+  case kSendFailed:
+    break;
+  }
+  fChunkSize = clamp(size_t(size), fChunkMin, fChunkMax);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns `msg` gzip compressed
+  \throws Exception if zlib fails
+ */
+
+string MonitorSinkInflux::Gzip(const string& msg) {
+  z_stream zs{};
+  // windowBits 15 + 16 selects the gzip format
+  if (deflateInit2(&zs, kGzipLevel, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    throw Exception("MonitorSinkInflux::Gzip: deflateInit2 failed");
+  string res(deflateBound(&zs, uLong(msg.size())), '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(msg.data()));
+  zs.avail_in = uInt(msg.size());
+  zs.next_out = reinterpret_cast<Bytef*>(res.data());
+  zs.avail_out = uInt(res.size());
+  int rc = deflate(&zs, Z_FINISH);
+  res.resize(zs.total_out);
+  deflateEnd(&zs);
+  if (rc != Z_STREAM_END)
+    throw Exception("MonitorSinkInflux::Gzip: deflate failed");
+  return res;
+}
+
+} // end namespace cbm
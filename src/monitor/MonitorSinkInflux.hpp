@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkInflux
+#define included_Cbm_MonitorSinkInflux 1
+
+#include "MonitorSink.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkInflux : public MonitorSink {
+public:
+  MonitorSinkInflux(Monitor& monitor,
+                    const string& path,
+                    const string& cname);
+  virtual ~MonitorSinkInflux();
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+  virtual void ProcessHeartbeat();
+  void ProcessMetricPtrVec(const vector<const Metric*>& metvec);
+
+protected:
+  enum SendStatus {
+    kSendOK = 0,   //!< accepted by server
+    kSendTooLarge, //!< rejected as too large (HTTP 413)
+    kSendOverload, //!< server overloaded (HTTP 429, 5xx, timeout)
+    kSendNoConn,   //!< server not reachable (resolve or connect failed)
+    kSendFailed    //!< other failure, unrelated to chunk size
+  };
+
+  void SetEndpoint(const string& hosts, const string& port);
+  void StartLanes(size_t nlane);
+  void StopLanes();
+  void QueueChunk(size_t ilane, string&& msg);
+  void LaneLoop(size_t ilane);
+  void SendChunk(const string& msg);
+  SendStatus SendData(const string& msg, double& rtt, bool retry = true);
+  void AdaptChunkSize(size_t nbyte, SendStatus stat, double rtt);
+  static string Gzip(const string& msg);
+
+protected:
+  struct Conn; // persistent connection, defined in .cpp
+  struct Lane {
+    deque<string> fQueue{}; //!< chunks waiting for send
+    thread fThread{};       //!< send thread
+  };
+
+  string fClassName;                        //!< class name for messages
+  vector<string> fHosts;                    //!< server host name and replicas
+  atomic<size_t> fHostIndex{0};             //!< index of active host
+  string fPort;                             //!< port for InfluxDB
+  string fTarget;                           //!< HTTP target of write endpoint
+  vector<pair<string, string>> fHttpFields; //!< extra HTTP header fields
+  atomic<size_t> fChunkSize;                //!< current send chunk size
+  size_t fChunkMin;                         //!< lower bound of fChunkSize
+  size_t fChunkMax;                         //!< upper bound of fChunkSize
+  double fSendTimeout;                      //!< timeout for one send (in s)
+  double fSendTarget;                       //!< target time for one send (in s)
+  long fStatNFailover{0};                   //!< # of switches to a replica
+  mutex fStatMutex{};                       //!< mutex for send stats
+  vector<unique_ptr<Lane>> fLanes{};        //!< send lanes, empty if serial
+  mutex fLaneMutex{};                       //!< mutex for lane queues
+  condition_variable fLaneCond{};           //!< signals queued chunks
+  condition_variable fSpaceCond{};          //!< signals inflight space
+  size_t fInflight{0};                      //!< bytes queued or in send
+  size_t fInflightMax{0};                   //!< limit for fInflight
+  bool fLaneStop{false};                    //!< signals lane rundown
+  bool fGzip;                               //!< send gzip compressed bodies
+  bool fKeepAlive;                          //!< reuse connections
+  mutex fConnMutex{};                       //!< mutex for fConnPool
+  vector<unique_ptr<Conn>> fConnPool{};     //!< idle persistent connections
+  long fStatNConnect{0};                    //!< # of new connections
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkInflux.ipp"
+
+#endif
@@ -5,25 +5,17 @@
 #ifndef included_Cbm_MonitorSinkInflux1
 #define included_Cbm_MonitorSinkInflux1 1
 
-#include "MonitorSink.hpp"
+#include "MonitorSinkInflux.hpp"
 
 namespace cbm {
 using namespace std;
 
-class MonitorSinkInflux1 : public MonitorSink {
+class MonitorSinkInflux1 : public MonitorSinkInflux {
 public:
   MonitorSinkInflux1(Monitor& monitor, const string& path);
 
-  virtual void ProcessMetricVec(const vector<Metric>& metvec);
-  virtual void ProcessHeartbeat();
-
-private:
-  void SendData(const string& msg);
-
 private:
-  string fHost; //!< server host name
-  string fPort; //!< port for InfluxDB
-  string fDB;   //!< target database
+  string fDB; //!< target database
 };
 
 } // end namespace cbm
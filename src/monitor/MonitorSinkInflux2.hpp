@@ -5,24 +5,16 @@
 #ifndef included_Cbm_MonitorSinkInflux2
 #define included_Cbm_MonitorSinkInflux2 1
 
-#include "MonitorSink.hpp"
+#include "MonitorSinkInflux.hpp"
 
 namespace cbm {
 using namespace std;
 
-class MonitorSinkInflux2 : public MonitorSink {
+class MonitorSinkInflux2 : public MonitorSinkInflux {
 public:
   MonitorSinkInflux2(Monitor& monitor, const string& path);
 
-  virtual void ProcessMetricVec(const vector<Metric>& metvec);
-  virtual void ProcessHeartbeat();
-
-private:
-  void SendData(const string& msg);
-
 private:
-  string fHost;   //!< server host name
-  string fPort;   //!< port for InfluxDB
   string fBucket; //!< target bucket
   string fToken;  //!< access token
 };
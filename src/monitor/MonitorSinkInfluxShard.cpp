@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkInfluxShard.hpp"
+
+#include "Exception.hpp"
+#include "MonitorSinkInflux1.hpp"
+#include "MonitorSinkInflux2.hpp"
+
+#include "fmt/format.h"
+
+namespace cbm {
+using namespace std;
+
+/*! \class MonitorSinkInfluxShard
+  \brief Monitor sink - distributes metrics over several InfluxDB instances
+
+  Each point is routed to one shard by a stable hash of its series key, the
+  measurement plus the tagset (see MonitorSink::SeriesHash()). All points of
+  a series therefore always land on the same server, as long as the list of
+  shards is not changed.
+
+  Each shard is a complete MonitorSinkInflux1 or MonitorSinkInflux2 sink with
+  its own connection, batching, chunk size adaption and self-monitoring. The
+  "Monitor" metrics of a shard are tagged with `shard=<index>`. Replicas for
+  failover are given per shard as a host list, see MonitorSinkInflux.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    `;` separated list of shard sink names
+  \throws Exception if the list is empty or a shard is not an Influx sink
+
+  Each element of `path` is a sink name as accepted by Monitor::OpenSink()
+  with type `influx1` or `influx2`, including its options, e.g.
+  \code
+    influx2:db-a,db-a2:8086:cbm:;influx2:db-b,db-b2:8086:cbm:?parallel=2
+  \endcode
+  creates two shards, each with a replica.
+ */
+
+MonitorSinkInfluxShard::MonitorSinkInfluxShard(Monitor& monitor,
+                                               const string& path)
+    : MonitorSink(monitor, path) {
+  size_t pbeg = 0;
+  while (pbeg <= path.size()) {
+    size_t pend = path.find(';', pbeg);
+    if (pend == string::npos)
+      pend = path.size();
+    string sname = path.substr(pbeg, pend - pbeg);
+    pbeg = pend + 1;
+    if (sname.empty())
+      continue;
+
+    auto pos = sname.find(':');
+    string stype = sname.substr(0, pos);
+    string spath = pos == string::npos ? ""s : sname.substr(pos + 1);
+    if (stype == "influx1") {
+      fShards.push_back(make_unique<MonitorSinkInflux1>(monitor, spath));
+    } else if (stype == "influx2") {
+      fShards.push_back(make_unique<MonitorSinkInflux2>(monitor, spath));
+    } else {
+      throw Exception(fmt::format("MonitorSinkInfluxShard::ctor:"
+                                  " invalid shard type '{}' in '{}'",
+                                  stype, sname));
+    }
+    fShards.back()->SetStatTags({{"shard", to_string(fShards.size() - 1)}});
+  }
+  if (fShards.empty())
+    throw Exception(fmt::format("MonitorSinkInfluxShard::ctor:"
+                                " no shards given in '{}'",
+                                path));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+ */
+
+void MonitorSinkInfluxShard::ProcessMetricVec(const vector<Metric>& metvec) {
+  size_t nshard = fShards.size();
+  vector<vector<const Metric*>> shardvec(nshard);
+  for (auto& met : metvec)
+    shardvec[size_t(SeriesHash(met) % nshard)].push_back(&met);
+  for (size_t i = 0; i < nshard; i++)
+    if (!shardvec[i].empty())
+      fShards[i]->ProcessMetricPtrVec(shardvec[i]);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat, forwarded to all shards
+ */
+
+void MonitorSinkInfluxShard::ProcessHeartbeat() {
+  for (auto& shard : fShards)
+    shard->ProcessHeartbeat();
+}
+
+} // end namespace cbm
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkInfluxShard
+#define included_Cbm_MonitorSinkInfluxShard 1
+
+#include "MonitorSinkInflux.hpp"
+
+#include <memory>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkInfluxShard : public MonitorSink {
+public:
+  MonitorSinkInfluxShard(Monitor& monitor, const string& path);
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+  virtual void ProcessHeartbeat();
+
+private:
+  vector<unique_ptr<MonitorSinkInflux>> fShards{}; //!< shard sinks
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkInfluxShard.ipp"
+
+#endif
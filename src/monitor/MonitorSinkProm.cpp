@@ -0,0 +1,410 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkProm.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "Monitor.hpp"
+#include "PThreadHelper.hpp"
+#include "SysCallException.hpp"
+
+#include "fmt/format.h"
+
+#include <cctype>
+#include <cmath>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const int kReadTimeout = 2000;     // timeout for request I/O (ms)
+static const size_t kMaxHeadSize = 16384; // limit for HTTP request head
+
+/*! \class MonitorSinkProm
+  \brief Monitor sink - concrete sink serving a Prometheus scrape endpoint
+
+  Keeps the latest value of each series in an in-memory table and serves it
+  in the Prometheus text exposition format via a small embedded HTTP server
+  running on its own thread. Prometheus scrapes `http://host:port/metrics`.
+
+  Each field of a Metric is mapped to a Prometheus series
+  - the metric name is `<measurement>_<field>`, characters not allowed in
+    Prometheus metric names are replaced by `_`
+  - the tags become labels
+  - boolean fields are exported as 0 or 1, string fields are skipped
+  - the timestamp of the Metric is not exported, the scrape time is used
+
+  All series are exported with type `gauge`. The rendered page is cached and
+  only rebuilt by a scrape when a value changed since the last render, so a
+  high scrape rate costs little more than the socket I/O.
+
+  The sink writes periodically some self-monitoring data as Metric to
+  measurement "Monitor" with the fields
+  - `points`: number of metrics in last period
+  - `tags`: total number of tags in all metrics in last period
+  - `fields`: total number of fields in all metrics in last period
+  - `series`: number of series in the table
+  - `scrapes`: number of served scrapes in last period
+  - `renders`: number of page renders in last period
+  - `skipped`: number of skipped string fields in last period
+
+  The Metric is tagged with the tags set with SetStatTags().
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    port number, options may follow
+  \throws Exception if `path` is not a port number or an option is invalid
+  \throws SysCallException in case a system call fails
+
+  The port can be followed by `?` and these options
+  - `addr`: IPv4 address to bind to (default '0.0.0.0', all interfaces)
+  - `expire`: remove series not updated for this time in s, checked at each
+    heartbeat (default '0', never)
+ */
+
+MonitorSinkProm::MonitorSinkProm(Monitor& monitor, const string& path)
+    : MonitorSink(monitor, path) {
+  fOptions.Check("MonitorSinkProm::ctor", {"addr", "expire"});
+  fExpire = fOptions.Double("expire", 0.);
+  string saddr = fOptions.String("addr", "0.0.0.0");
+
+  char* pend = nullptr;
+  long port = ::strtol(fOptions.Path().c_str(), &pend, 10);
+  if (fOptions.Path().empty() || *pend != '\0' || port < 0 || port > 65535)
+    throw Exception(
+        fmt::format("MonitorSinkProm::ctor: path not a port '{}'", path));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(uint16_t(port));
+  if (::inet_pton(AF_INET, saddr.c_str(), &addr.sin_addr) != 1)
+    throw Exception(fmt::format("MonitorSinkProm::ctor: invalid addr '{}'"
+                                " in '{}'",
+                                saddr, path));
+
+  int fd = ::eventfd(0U, 0);
+  if (fd < 0)
+    throw SysCallException("MonitorSinkProm::ctor"s, "eventfd"s, errno);
+  fEvtFd.Set(fd);
+  fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    throw SysCallException("MonitorSinkProm::ctor"s, "socket"s, errno);
+  fListenFd.Set(fd);
+  int one = 1;
+  (void)::setsockopt(fListenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (::bind(fListenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    throw SysCallException("MonitorSinkProm::ctor"s, "bind"s,
+                           fOptions.Path(), errno);
+  if (::listen(fListenFd, 16) < 0)
+    throw SysCallException("MonitorSinkProm::ctor"s, "listen"s, errno);
+
+  fThread = thread([this]() { ServerLoop(); });
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor
+
+  Calls Stop(), which terminates the HTTP server thread.
+ */
+
+MonitorSinkProm::~MonitorSinkProm() { Stop(); }
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+
+  Updates the table, the page is marked for re-render only when a series is
+  added or a value changed.
+ */
+
+void MonitorSinkProm::ProcessMetricVec(const vector<Metric>& metvec) {
+  lock_guard<mutex> lock(fTableMutex);
+  fStatNPoint += metvec.size();
+  for (auto& met : metvec) {
+    fStatNTag += met.fTagset.size();
+    fStatNField += met.fFieldset.size();
+
+    string labels;
+    for (auto& tag : met.fTagset) {
+      labels += labels.empty() ? "{" : ",";
+      labels += LabelName(tag.first) + "=\"" + LabelValue(tag.second) + "\"";
+    }
+    if (!labels.empty())
+      labels += "}";
+
+    string prefix = MetricName(met.fMeasurement) + "_";
+    for (auto& field : met.fFieldset) {
+      double val = 0.;
+      if (!NumericField(field.second, val)) {
+        fStatNSkip += 1;
+        continue;
+      }
+      auto& family = fTable[prefix + MetricName(field.first)];
+      auto [it, isnew] = family.try_emplace(labels);
+      if (isnew) {
+        fNSeries += 1;
+        fDirty = true;
+      } else if (it->second.fValue != val) {
+        fDirty = true;
+      }
+      it->second.fValue = val;
+      it->second.fTime = met.fTimestamp;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat
+
+  Also removes expired series when the `expire` option was given.
+ */
+
+void MonitorSinkProm::ProcessHeartbeat() {
+  lock_guard<mutex> lock(fTableMutex);
+  if (fExpire > 0.) {
+    auto tmin = ScNow() - chrono::duration_cast<scduration>(
+                              chrono::duration<double>(fExpire));
+    for (auto fit = fTable.begin(); fit != fTable.end();) {
+      auto& family = fit->second;
+      for (auto sit = family.begin(); sit != family.end();) {
+        if (sit->second.fTime < tmin) {
+          sit = family.erase(sit);
+          fNSeries -= 1;
+          fDirty = true;
+        } else {
+          ++sit;
+        }
+      }
+      fit = family.empty() ? fTable.erase(fit) : next(fit);
+    }
+  }
+
+  Monitor::Ref().QueueMetric("Monitor", // measurement
+                             fStatTags, // extra tags
+                             {{"points", fStatNPoint}, // fields
+                              {"tags", fStatNTag},
+                              {"fields", fStatNField},
+                              {"series", fNSeries},
+                              {"scrapes", fStatNScrape},
+                              {"renders", fStatNRender},
+                              {"skipped", fStatNSkip}});
+  fStatNPoint = 0;
+  fStatNTag = 0;
+  fStatNField = 0;
+  fStatNScrape = 0;
+  fStatNRender = 0;
+  fStatNSkip = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns `str` as valid Prometheus metric name
+
+  Characters other than `[a-zA-Z0-9_:]` are replaced by `_`, a leading
+  digit is prefixed with `_`.
+ */
+
+string MonitorSinkProm::MetricName(const string& str) {
+  string res = str;
+  for (auto& c : res)
+    if (!isalnum((unsigned char)c) && c != '_' && c != ':')
+      c = '_';
+  if (res.empty() || isdigit((unsigned char)res[0]))
+    res.insert(0, "_");
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns `str` as valid Prometheus label name
+
+  Like MetricName(), but `:` is replaced by `_` too, it is not allowed in
+  label names.
+ */
+
+string MonitorSinkProm::LabelName(const string& str) {
+  string res = str;
+  for (auto& c : res)
+    if (!isalnum((unsigned char)c) && c != '_')
+      c = '_';
+  if (res.empty() || isdigit((unsigned char)res[0]))
+    res.insert(0, "_");
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns `str` with `\`, `"` and newline escaped for a label value
+ */
+
+string MonitorSinkProm::LabelValue(const string& str) {
+  string res;
+  res.reserve(str.size());
+  for (char c : str) {
+    if (c == '\\' || c == '"') {
+      res += '\\';
+      res += c;
+    } else if (c == '\n') {
+      res += "\\n";
+    } else {
+      res += c;
+    }
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns `val` in the exposition format
+
+  Infinities and NaN are written as `+Inf`, `-Inf` and `NaN`.
+ */
+
+string MonitorSinkProm::SampleValue(double val) {
+  if (isnan(val))
+    return "NaN";
+  if (isinf(val))
+    return val > 0. ? "+Inf" : "-Inf";
+  return fmt::format("{}", val);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the exposition page, renders it only when the table changed
+ */
+
+shared_ptr<const string> MonitorSinkProm::Page() {
+  lock_guard<mutex> lock(fTableMutex);
+  fStatNScrape += 1;
+  if (fDirty || !fPage) {
+    string page;
+    for (auto& [name, family] : fTable) {
+      page += "# TYPE " + name + " gauge\n";
+      for (auto& [labels, sample] : family)
+        page += name + labels + " " + SampleValue(sample.fValue) + "\n";
+    }
+    fPage = make_shared<const string>(move(page));
+    fDirty = false;
+    fStatNRender += 1;
+  }
+  return fPage;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Stop HTTP server thread
+ */
+
+void MonitorSinkProm::Stop() {
+  fStopped = true;
+  uint64_t one(1);
+  if (::write(fEvtFd, &one, sizeof(one)) != sizeof(one))
+    throw SysCallException("MonitorSinkProm::Stop"s, "write"s, "fEvtFd"s,
+                           errno);
+  if (fThread.joinable())
+    fThread.join();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief The accept loop of the HTTP server thread
+ */
+
+void MonitorSinkProm::ServerLoop() {
+  SetPThreadName("Cbm:monprom");
+
+  pollfd polllist[2];
+  polllist[0] = pollfd{fEvtFd, POLLIN, 0};
+  polllist[1] = pollfd{fListenFd, POLLIN, 0};
+
+  while (!fStopped) {
+    if (::poll(polllist, 2, -1) < 0)
+      continue; // EINTR
+    if (polllist[0].revents)
+      break;
+    if (!(polllist[1].revents & POLLIN))
+      continue;
+    int fd = ::accept4(fListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+      continue;
+    Serve(fd);
+    (void)::close(fd);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Serve one request, the connection is closed afterwards
+  \param fd   fd of connection socket
+
+  Only `GET` of `/metrics` or `/` is answered with the page, other requests
+  get a `404 Not Found`. Requests not complete within 2 s are dropped, and
+  a response not accepted by the client within 2 s is aborted.
+ */
+
+void MonitorSinkProm::Serve(int fd) {
+  timeval tmo{kReadTimeout / 1000, 0};
+  (void)::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tmo, sizeof(tmo));
+  string head;
+  char rbuf[4096];
+  while (head.find("\r\n\r\n") == string::npos) {
+    pollfd pfd{fd, POLLIN, 0};
+    if (::poll(&pfd, 1, kReadTimeout) <= 0 || head.size() > kMaxHeadSize)
+      return;
+    ssize_t nrd = ::recv(fd, rbuf, sizeof(rbuf), 0);
+    if (nrd <= 0)
+      return;
+    head.append(rbuf, size_t(nrd));
+  }
+
+  string target = head.substr(0, head.find("\r\n"));
+  bool get = target.compare(0, 4, "GET ") == 0;
+  target = get ? target.substr(4, target.find(' ', 4) - 4) : ""s;
+  target = target.substr(0, target.find('?'));
+
+  shared_ptr<const string> page;
+  string rhead;
+  if (get && (target == "/metrics" || target == "/")) {
+    page = Page();
+    rhead = fmt::format("HTTP/1.1 200 OK\r\n"
+                        "Content-Type: text/plain; version=0.0.4\r\n"
+                        "Content-Length: {}\r\n"
+                        "Connection: close\r\n\r\n",
+                        page->size());
+  } else {
+    rhead = "HTTP/1.1 404 Not Found\r\n"
+            "Content-Length: 0\r\n"
+            "Connection: close\r\n\r\n";
+  }
+
+  iovec iovs[2];
+  iovs[0].iov_base = rhead.data();
+  iovs[0].iov_len = rhead.size();
+  iovs[1].iov_base = page ? const_cast<char*>(page->data()) : nullptr;
+  iovs[1].iov_len = page ? page->size() : 0;
+  size_t niov = page ? 2 : 1;
+  iovec* piov = iovs;
+  while (niov > 0) {
+    msghdr msg{};
+    msg.msg_iov = piov;
+    msg.msg_iovlen = niov;
+    ssize_t nwr = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if (nwr < 0)
+      return;
+    size_t nrest = size_t(nwr);
+    while (niov > 0 && nrest >= piov->iov_len) {
+      nrest -= piov->iov_len;
+      piov++;
+      niov--;
+    }
+    if (niov > 0) {
+      piov->iov_base = static_cast<char*>(piov->iov_base) + nrest;
+      piov->iov_len -= nrest;
+    }
+  }
+}
+
+} // end namespace cbm
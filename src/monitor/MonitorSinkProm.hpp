@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkProm
+#define included_Cbm_MonitorSinkProm 1
+
+#include "ChronoDefs.hpp"
+#include "FileDescriptor.hpp"
+#include "MonitorSink.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkProm : public MonitorSink {
+public:
+  MonitorSinkProm(Monitor& monitor, const string& path);
+  virtual ~MonitorSinkProm();
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+  virtual void ProcessHeartbeat();
+
+private:
+  struct Sample {
+    double fValue{0.};    //!< latest value
+    sctime_point fTime{}; //!< time of last update
+  };
+  using family_t = map<string, Sample>; //!< samples keyed by label set
+
+  static string MetricName(const string& str);
+  static string LabelName(const string& str);
+  static string LabelValue(const string& str);
+  static string SampleValue(double val);
+  shared_ptr<const string> Page();
+  void Stop();
+  void ServerLoop();
+  void Serve(int fd);
+
+private:
+  FileDescriptor fListenFd{};       //!< fd of listen socket
+  FileDescriptor fEvtFd{};          //!< fd for eventfd, signals stop
+  thread fThread{};                 //!< HTTP server thread
+  atomic<bool> fStopped{false};     //!< signals thread rundown
+  double fExpire;                   //!< expire time of series (in s)
+  mutex fTableMutex{};              //!< mutex for table, page and stats
+  map<string, family_t> fTable{};   //!< families keyed by metric name
+  size_t fNSeries{0};               //!< # of series in fTable
+  bool fDirty{true};                //!< table changed since last render
+  shared_ptr<const string> fPage{}; //!< cached exposition page
+  long fStatNScrape{0};             //!< # of served scrapes
+  long fStatNRender{0};             //!< # of page renders
+  long fStatNSkip{0};               //!< # of skipped string fields
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkProm.ipp"
+
+#endif
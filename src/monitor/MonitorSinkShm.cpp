@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkShm.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "Monitor.hpp"
+
+#include "fmt/format.h"
+
+namespace cbm {
+using namespace std;
+// some constants
+static const size_t kRingSize = 4194304; // default ring capacity
+static const size_t kRecordSize = 65536; // default record size
+
+/*! \class MonitorSinkShm
+  \brief Monitor sink - concrete sink for a shared memory ring
+
+  Writes the metrics in InfluxDB line format into a MonitorShmRing, a ring
+  buffer in POSIX shared memory. A separate long-lived reader process on
+  the node, like `monitor_shmcat`, drains the ring and ships the metrics.
+  The Monitor thread only copies data into memory, it never blocks on I/O
+  and never waits for the reader.
+
+  The lines are collected in records of at most `record` bytes, a line is
+  never split, a line longer than `record` is dropped. When the reader is
+  too slow the oldest records are overwritten, they are counted in the
+  ring header and in the heartbeat.
+
+  The sink writes periodically some self-monitoring data as Metric to
+  measurement "Monitor" with the fields
+  - `points`: number of metrics in last period
+  - `tags`: total number of tags in all metrics in last period
+  - `fields`: total number of fields in all metrics in last period
+  - `sends`: number of written records in last period
+  - `bytes`: total number bytes written in last period
+  - `sndtime`: total elapsed time spend in writing records (in s)
+  - `fill`: bytes currently in the ring
+  - `overwrites`: number of records overwritten before read in last period
+  - `overwritebytes`: total bytes in overwritten records in last period
+  - `drops`: number of lines or records rejected as too large in last
+    period
+
+  The Metric is tagged with the tags set with SetStatTags().
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    ring name, options may follow
+  \throws Exception if `path` is empty or an option is invalid
+
+  Creates the ring `/dev/shm/cbmmon_<name>`, see MonitorShmRing::ShmName().
+  The name can be followed by `?` and these options
+  - `size`: capacity of the ring in bytes, rounded up to a power of 2
+    (default '4M')
+  - `record`: max size of a record in bytes (default '64k'), at most half
+    of the ring capacity
+ */
+
+MonitorSinkShm::MonitorSinkShm(Monitor& monitor, const string& path)
+    : MonitorSink(monitor, path) {
+  fOptions.Check("MonitorSinkShm::ctor", {"size", "record"});
+  const string& name = fOptions.Path();
+  if (name.empty() || name.find('/') != string::npos)
+    throw Exception(fmt::format("MonitorSinkShm::ctor: name empty or"
+                                " containing '/' in '{}'",
+                                path));
+  size_t size = fOptions.Size("size", kRingSize);
+  fRecordSize = fOptions.Size("record", kRecordSize);
+  if (fRecordSize == 0 || 2 * (fRecordSize + 8) > size)
+    throw Exception(fmt::format("MonitorSinkShm::ctor: record must be > 0"
+                                " and at most half of size in '{}'",
+                                path));
+  fRing = make_unique<MonitorShmRing>(name, size);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+ */
+
+void MonitorSinkShm::ProcessMetricVec(const vector<Metric>& metvec) {
+  auto tbeg = ScNow();
+  fStatNPoint += metvec.size();
+  string record;
+  auto write = [this, &record]() {
+    if (fRing->Write(record)) { // a rejected record is counted by the ring
+      fStatNSend += 1;
+      fStatNByte += record.size();
+    }
+    record.clear();
+  };
+  for (auto& met : metvec) {
+    fStatNTag += met.fTagset.size();
+    fStatNField += met.fFieldset.size();
+    string line = InfluxLine(met) + "\n"s;
+    if (line.size() > fRecordSize) {
+      fStatNDrop += 1;
+      continue;
+    }
+    if (!record.empty() && record.size() + line.size() > fRecordSize)
+      write();
+    record += line;
+  }
+  if (!record.empty())
+    write();
+  fStatSndTime += ScTimeDiff2Double(tbeg, ScNow());
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat
+ */
+
+void MonitorSinkShm::ProcessHeartbeat() {
+  auto stats = fRing->Statistics();
+  Monitor::Ref().QueueMetric(
+      "Monitor", // measurement
+      fStatTags, // extra tags
+      {{"points", fStatNPoint}, // fields
+       {"tags", fStatNTag},
+       {"fields", fStatNField},
+       {"sends", fStatNSend},
+       {"bytes", fStatNByte},
+       {"sndtime", fStatSndTime}, // 'time' not allowed
+       {"fill", stats.fFill},
+       {"overwrites", stats.fNOverwrite - fLastStats.fNOverwrite},
+       {"overwritebytes", stats.fNOverwriteByte - fLastStats.fNOverwriteByte},
+       {"drops", fStatNDrop + long(stats.fNDrop - fLastStats.fNDrop)}});
+  fLastStats = stats;
+  fStatNPoint = 0;
+  fStatNTag = 0;
+  fStatNField = 0;
+  fStatNSend = 0;
+  fStatNByte = 0;
+  fStatSndTime = 0.;
+  fStatNDrop = 0;
+}
+
+} // end namespace cbm
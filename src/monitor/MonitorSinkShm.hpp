@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkShm
+#define included_Cbm_MonitorSinkShm 1
+
+#include "MonitorShmRing.hpp"
+#include "MonitorSink.hpp"
+
+#include <memory>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkShm : public MonitorSink {
+public:
+  MonitorSinkShm(Monitor& monitor, const string& path);
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+  virtual void ProcessHeartbeat();
+
+private:
+  unique_ptr<MonitorShmRing> fRing{}; //!< ring in shared memory
+  size_t fRecordSize;                 //!< max size of a record
+  MonitorShmRing::Stats fLastStats{}; //!< ring stats at last heartbeat
+  long fStatNDrop{0};                 //!< # of lines dropped as too large
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkShm.ipp"
+
+#endif
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkStatsd.hpp"
+
+#include "Exception.hpp"
+
+#include "fmt/format.h"
+
+#include <cstring>
+
+namespace cbm {
+using namespace std;
+
+/*! \class MonitorSinkStatsd
+  \brief Monitor sink - concrete sink for StatsD and DogStatsD over UDP
+
+  Sends the metrics as StatsD lines to a StatsD compatible aggregator, like
+  the Etsy statsd, the statsd input of Telegraf, or the DogStatsD agent.
+  The datagram packing and sending is provided by MonitorSinkUdp, several
+  lines are packed into one datagram separated by newlines.
+
+  Each numeric or boolean field of a Metric is mapped to a StatsD metric
+  named `<measurement>.<field>`. By default it is sent as gauge (`|g`), the
+  fields listed in the `counters` option as counter (`|c`) and the fields
+  listed in the `timers` option as timer (`|ms`, the value must be in ms).
+  String fields are skipped.
+
+  The points of a batch are aggregated per series, a series being the
+  StatsD metric name plus the tags, before anything is sent
+  - gauges: only the last value is sent
+  - counters: the sum of all values is sent
+  - timers: all values are sent. With DogStatsD tags they are combined
+    in one multi-value line `name:v1:v2:...|ms`, otherwise one line per
+    value is sent
+
+  A negative gauge value is sent as absolute value by DogStatsD, but as a
+  decrement by Etsy statsd and Telegraf. Unless DogStatsD tags are used a
+  negative gauge is therefore preceded by a `name:0|g` line.
+
+  In addition to the MonitorSinkUdp fields the self-monitoring Metric has
+  - `series`: number of aggregated series sent in last period
+  - `skipped`: number of skipped string fields in last period
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    destination as `host:port`, options may follow
+  \throws Exception if `path` is not `host:port` or an option is invalid
+
+  The destination can be followed by `?` and the MonitorSinkUdp options as
+  well as these options
+  - `tags`: tag format, `dogstatsd` for `|#key:val,...` (default), `influx`
+    for the Telegraf format `name,key=val,...`, or `none`
+  - `counters`: comma separated list of fields sent as counter
+  - `timers`: comma separated list of fields sent as timer
+
+  A field in the `counters` and `timers` lists is given either as `field`,
+  matching that field in all measurements, or as `measurement.field`.
+ */
+
+MonitorSinkStatsd::MonitorSinkStatsd(Monitor& monitor, const string& path)
+    : MonitorSinkUdp(monitor, path, "MonitorSinkStatsd",
+                     {"tags", "counters", "timers"}) {
+  string stags = fOptions.String("tags", "dogstatsd");
+  if (stags == "dogstatsd") {
+    fTagMode = kTagsDog;
+  } else if (stags == "influx") {
+    fTagMode = kTagsInflux;
+  } else if (stags == "none") {
+    fTagMode = kTagsNone;
+  } else {
+    throw Exception(fmt::format("MonitorSinkStatsd::ctor: tags must be"
+                                " dogstatsd, influx or none in '{}'",
+                                path));
+  }
+  fCounters = FieldList(fOptions.String("counters", ""));
+  fTimers = FieldList(fOptions.String("timers", ""));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+
+  Aggregates the points per series, then packs and sends the StatsD lines.
+  The series are sent in the order of their first appearance in `metvec`.
+ */
+
+void MonitorSinkStatsd::ProcessMetricVec(const vector<Metric>& metvec) {
+  unordered_map<string, size_t> index; // series key -> index in series
+  vector<pair<string, Series>> series; // line head and aggregate
+  vector<string> tagsuff;              // line tail, tags for DogStatsD
+
+  fStatNPoint += metvec.size();
+  for (auto& met : metvec) {
+    fStatNTag += met.fTagset.size();
+    fStatNField += met.fFieldset.size();
+
+    string tags;
+    for (auto& tag : met.fTagset) {
+      if (fTagMode == kTagsDog) {
+        tags += tags.empty() ? "|#" : ",";
+        tags += CleanName(tag.first, fTagMode) + ":" +
+                CleanName(tag.second, fTagMode);
+      } else if (fTagMode == kTagsInflux) {
+        tags += "," + CleanName(tag.first, fTagMode) + "=" +
+                CleanName(tag.second, fTagMode);
+      }
+    }
+
+    string mname = CleanName(met.fMeasurement, fTagMode);
+    for (auto& field : met.fFieldset) {
+      double val = 0.;
+      if (!NumericField(field.second, val)) {
+        fStatNSkip += 1;
+        continue;
+      }
+      const string& fname = field.first;
+      string name = mname + "." + CleanName(fname, fTagMode);
+      string fullname = met.fMeasurement + "." + fname;
+      char type = 'g';
+      if (fCounters.count(fname) || fCounters.count(fullname))
+        type = 'c';
+      else if (fTimers.count(fname) || fTimers.count(fullname))
+        type = 't';
+
+      auto [it, isnew] = index.try_emplace(name + tags + type, series.size());
+      if (isnew) {
+        series.emplace_back(fTagMode == kTagsInflux ? name + tags : name,
+                            Series());
+        series.back().second.fType = type;
+        tagsuff.push_back(fTagMode == kTagsDog ? tags : ""s);
+      }
+      Series& ser = series[it->second].second;
+      if (type == 'g')
+        ser.fValue = val;
+      else if (type == 'c')
+        ser.fValue += val;
+      else
+        ser.fTimes.push_back(val);
+    }
+  }
+
+  for (size_t i = 0; i < series.size(); i++) {
+    const string& name = series[i].first;
+    const Series& ser = series[i].second;
+    const string& tags = tagsuff[i];
+    if (ser.fType == 'g') {
+      if (ser.fValue < 0. && fTagMode != kTagsDog)
+        PackLine(name + ":0|g" + tags + "\n");
+      PackLine(fmt::format("{}:{}|g{}\n", name, ser.fValue, tags));
+    } else if (ser.fType == 'c') {
+      PackLine(fmt::format("{}:{}|c{}\n", name, ser.fValue, tags));
+    } else if (fTagMode == kTagsDog) { // multi-value timer, within mtu
+      string line;
+      for (double val : ser.fTimes) {
+        string sval = fmt::format(":{}", val);
+        if (!line.empty() &&
+            line.size() + sval.size() + tags.size() + 4 > fMtu) {
+          PackLine(line + "|ms" + tags + "\n");
+          line.clear();
+        }
+        if (line.empty())
+          line = name;
+        line += sval;
+      }
+      PackLine(line + "|ms" + tags + "\n");
+    } else {
+      for (double val : ser.fTimes)
+        PackLine(fmt::format("{}:{}|ms{}\n", name, val, tags));
+    }
+  }
+  fStatNSeries += series.size();
+  SendDatagrams();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Splits a comma separated list of field names
+ */
+
+set<string> MonitorSinkStatsd::FieldList(const string& str) {
+  set<string> res;
+  size_t pbeg = 0;
+  while (pbeg < str.size()) {
+    size_t pend = str.find(',', pbeg);
+    if (pend == string::npos)
+      pend = str.size();
+    if (pend > pbeg)
+      res.insert(str.substr(pbeg, pend - pbeg));
+    pbeg = pend + 1;
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Replaces characters with a meaning in the StatsD line by `_`
+  \param str    name or tag key or value
+  \param mode   tag mode, determines the set of special characters
+ */
+
+string MonitorSinkStatsd::CleanName(const string& str, TagMode mode) {
+  const char* special = mode == kTagsInflux ? ":|@#\n ,=" : ":|@#\n,";
+  string res = str;
+  for (auto& c : res)
+    if (strchr(special, c))
+      c = '_';
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Add statsd specific fields to the self-monitoring metric
+ */
+
+void MonitorSinkStatsd::AddStatFields(MetricFieldSet& fields) {
+  fields.emplace_back("series", fStatNSeries);
+  fields.emplace_back("skipped", fStatNSkip);
+  fStatNSeries = 0;
+  fStatNSkip = 0;
+}
+
+} // end namespace cbm
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkStatsd
+#define included_Cbm_MonitorSinkStatsd 1
+
+#include "MonitorSinkUdp.hpp"
+
+#include <set>
+#include <unordered_map>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkStatsd : public MonitorSinkUdp {
+public:
+  MonitorSinkStatsd(Monitor& monitor, const string& path);
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+
+private:
+  enum TagMode {
+    kTagsDog = 0, //!< DogStatsD style, `name:1|g|#key:val`
+    kTagsInflux,  //!< Telegraf style, `name,key=val:1|g`
+    kTagsNone     //!< tags are dropped
+  };
+
+  struct Series {
+    char fType{'g'};         //!< 'g' for gauge, 'c' counter, 't' timer
+    double fValue{0.};       //!< last value (gauge) or sum (counter)
+    vector<double> fTimes{}; //!< values of timer
+  };
+
+  static set<string> FieldList(const string& str);
+  static string CleanName(const string& str, TagMode mode);
+  virtual void AddStatFields(MetricFieldSet& fields);
+
+private:
+  TagMode fTagMode;      //!< tag format
+  set<string> fCounters; //!< fields sent as counters
+  set<string> fTimers;   //!< fields sent as timers
+  long fStatNSeries{0};  //!< # of emitted aggregated series
+  long fStatNSkip{0};    //!< # of skipped string fields
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkStatsd.ipp"
+
+#endif
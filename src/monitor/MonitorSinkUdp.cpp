@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkUdp.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "Monitor.hpp"
+#include "SysCallException.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include <errno.h>
+#include <netdb.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const size_t kUdpMtu = 1400;     // default datagram payload size
+static const size_t kUdpMtuMax = 65507; // max UDP payload over IPv4
+static const size_t kSendBatch = 64;    // max datagrams per sendmmsg() call
+
+/*! \class MonitorSinkUdp
+  \brief Monitor sink - concrete sink for InfluxDB line format over UDP
+
+  Sends the metrics in InfluxDB line format as UDP datagrams, e.g. to the
+  UDP listener of Telegraf or InfluxDB 1.x. Whole lines are packed into
+  datagrams up to a maximal payload size, a line is never split. The
+  datagrams are sent with `sendmmsg(2)` in batches over a non-blocking
+  socket, so the Monitor thread never waits for the network.
+
+  The transfer is fire-and-forget. When the socket send buffer is full
+  (`EAGAIN` or `ENOBUFS`) or the receiver is not listening (`ECONNREFUSED`)
+  the datagram is dropped and counted.
+
+  The sink writes periodically some self-monitoring data as Metric to
+  measurement "Monitor" with the fields
+  - `points`: number of metrics in last period
+  - `tags`: total number of tags in all metrics in last period
+  - `fields`: total number of fields in all metrics in last period
+  - `sends`: number of `sendmmsg(2)` calls in last period
+  - `bytes`: total number bytes sent in last period
+  - `sndtime`: total elapsed time spend in `sendmmsg(2)` (in s)
+  - `datagrams`: number of sent datagrams in last period
+  - `drops`: number of dropped datagrams in last period
+  - `dropbytes`: total number of bytes in dropped datagrams in last period
+
+  The Metric is tagged with the tags set with SetStatTags().
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    destination as `host:port`, options may follow
+  \throws Exception if `path` is not `host:port` or an option is invalid
+  \throws SysCallException in case a system call fails
+
+  The destination can be followed by `?` and these options
+  - `mtu`: maximal datagram payload size in bytes (default '1400'). Should
+    fit into the path MTU and the buffer of the receiver (Telegraf default
+    is 64k, InfluxDB 1.x `udp-payload-size` default is 64k as well)
+  - `sndbuf`: size of the socket send buffer in bytes, e.g. '4M' (default
+    is the system default, limited by `net.core.wmem_max`)
+ */
+
+MonitorSinkUdp::MonitorSinkUdp(Monitor& monitor, const string& path)
+    : MonitorSinkUdp(monitor, path, "MonitorSinkUdp", {}) {}
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor for derived sinks
+  \param monitor back reference to Monitor
+  \param path    destination as `host:port`, options may follow
+  \param cname   class name of concrete sink, used in messages
+  \param okeys   option keys supported by the derived sink, in addition to
+                 `mtu` and `sndbuf`
+ */
+
+MonitorSinkUdp::MonitorSinkUdp(Monitor& monitor,
+                               const string& path,
+                               const string& cname,
+                               const vector<string>& okeys)
+    : MonitorSink(monitor, path), fClassName(cname) {
+  vector<string> keys = okeys;
+  keys.insert(keys.end(), {"mtu", "sndbuf"});
+  fOptions.Check(fClassName + "::ctor", keys);
+  fMtu = fOptions.Size("mtu", kUdpMtu);
+  if (fMtu == 0 || fMtu > kUdpMtuMax)
+    throw Exception(fmt::format("{}::ctor: mtu must be in [1,{}] in '{}'",
+                                fClassName, kUdpMtuMax, path));
+
+  const string& dest = fOptions.Path();
+  auto pos = dest.rfind(':');
+  if (pos == string::npos || pos == 0 || pos + 1 == dest.size())
+    throw Exception(fmt::format("{}::ctor: path not host:port '{}'",
+                                fClassName, path));
+  string host = dest.substr(0, pos);
+  string port = dest.substr(pos + 1);
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  addrinfo* pres = nullptr;
+  int rc = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &pres);
+  if (rc != 0)
+    throw Exception(fmt::format("{}::ctor: getaddrinfo() failed for '{}':"
+                                " {}",
+                                fClassName, dest, gai_strerror(rc)));
+  unique_ptr<addrinfo, decltype(&::freeaddrinfo)> ures(pres, ::freeaddrinfo);
+
+  int fd = ::socket(pres->ai_family,
+                    pres->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                    pres->ai_protocol);
+  if (fd < 0)
+    throw SysCallException(fClassName + "::ctor", "socket"s, errno);
+  fSockFd.Set(fd);
+
+  if (fOptions.Has("sndbuf")) {
+    int sndbuf = int(min(fOptions.Size("sndbuf", 0), size_t(INT32_MAX)));
+    if (::setsockopt(fSockFd, SOL_SOCKET, SO_SNDBUF, &sndbuf,
+                     sizeof(sndbuf)) < 0)
+      throw SysCallException(fClassName + "::ctor", "setsockopt"s,
+                             "SO_SNDBUF"s, errno);
+  }
+
+  // connect, so no address is needed for each send and ICMP port
+  // unreachable messages are reported as ECONNREFUSED
+  if (::connect(fSockFd, pres->ai_addr, pres->ai_addrlen) < 0)
+    throw SysCallException(fClassName + "::ctor", "connect"s, dest, errno);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+ */
+
+void MonitorSinkUdp::ProcessMetricVec(const vector<Metric>& metvec) {
+  fStatNPoint += metvec.size();
+  for (auto& met : metvec) {
+    fStatNTag += met.fTagset.size();
+    fStatNField += met.fFieldset.size();
+    PackLine(InfluxLine(met) + "\n"s);
+  }
+  SendDatagrams();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat
+ */
+
+void MonitorSinkUdp::ProcessHeartbeat() {
+  MetricFieldSet fields = {{"points", fStatNPoint}, // fields
+                           {"tags", fStatNTag},
+                           {"fields", fStatNField},
+                           {"sends", fStatNSend},
+                           {"bytes", fStatNByte},
+                           {"sndtime", fStatSndTime}, // 'time' not allowed
+                           {"datagrams", fStatNDatagram},
+                           {"drops", fStatNDrop},
+                           {"dropbytes", fStatNDropByte}};
+  AddStatFields(fields);
+  Monitor::Ref().QueueMetric("Monitor", // measurement
+                             fStatTags, // extra tags
+                             move(fields));
+  fStatNPoint = 0;
+  fStatNTag = 0;
+  fStatNField = 0;
+  fStatNSend = 0;
+  fStatNByte = 0;
+  fStatSndTime = 0.;
+  fStatNDatagram = 0;
+  fStatNDrop = 0;
+  fStatNDropByte = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Add a line to the pending datagrams
+  \param line   line including the terminating newline
+
+  The line is appended to the last pending datagram when it fits, otherwise
+  a new datagram is started. A line longer than the `mtu` gets a datagram of
+  its own, it might be fragmented or rejected by the kernel.
+ */
+
+void MonitorSinkUdp::PackLine(string_view line) {
+  if (fDatagrams.empty() || fDatagrams.back().second + line.size() > fMtu)
+    fDatagrams.emplace_back(fBuffer.size(), 0);
+  fBuffer.append(line);
+  fDatagrams.back().second += line.size();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Send all pending datagrams
+
+  Datagrams are sent in batches with `sendmmsg(2)`. A datagram which can't
+  be sent is dropped and counted, the following ones are still tried.
+ */
+
+void MonitorSinkUdp::SendDatagrams() {
+  size_t ndgram = fDatagrams.size();
+  if (ndgram == 0)
+    return;
+
+  vector<iovec> iovs(ndgram);
+  vector<mmsghdr> msgs(ndgram);
+  for (size_t i = 0; i < ndgram; i++) {
+    iovs[i].iov_base = fBuffer.data() + fDatagrams[i].first;
+    iovs[i].iov_len = fDatagrams[i].second;
+    msgs[i].msg_hdr = msghdr{};
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  auto tbeg = ScNow();
+  size_t nlogged = 0;
+  size_t idgram = 0;
+  while (idgram < ndgram) {
+    unsigned nbatch = unsigned(min(kSendBatch, ndgram - idgram));
+    int nsent = ::sendmmsg(fSockFd, &msgs[idgram], nbatch, 0);
+    fStatNSend += 1;
+    if (nsent > 0) {
+      for (size_t i = idgram; i < idgram + size_t(nsent); i++)
+        fStatNByte += msgs[i].msg_len;
+      fStatNDatagram += nsent;
+      idgram += size_t(nsent);
+      continue;
+    }
+    if (nsent < 0 && errno == EINTR)
+      continue;
+
+    // first datagram of batch failed, drop it and go on
+    int eno = nsent < 0 ? errno : 0;
+    fStatNDrop += 1;
+    fStatNDropByte += iovs[idgram].iov_len;
+    idgram += 1;
+    if (eno == EAGAIN || eno == EWOULDBLOCK || eno == ENOBUFS ||
+        eno == ECONNREFUSED || nlogged > 0)
+      continue;
+    nlogged += 1; // report unexpected errors once per batch
+#if defined(CBMLOGERR1)
+    CBMLOGERR1("cid=__Monitor", "SendData-err")
+        << "sinkname=" << fSinkPath << ", error=" << ::strerror(eno);
+#else
+    std::cerr << fClassName << "::SendDatagrams error: "
+              << "sinkname=" << fSinkPath << ", error=" << ::strerror(eno)
+              << "\n";
+#endif
+  }
+  fStatSndTime += ScTimeDiff2Double(tbeg, ScNow());
+
+  fBuffer.clear();
+  fDatagrams.clear();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Hook for derived sinks to add fields to the self-monitoring metric
+ */
+
+void MonitorSinkUdp::AddStatFields(MetricFieldSet&) {}
+
+} // end namespace cbm
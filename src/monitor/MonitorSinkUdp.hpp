@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkUdp
+#define included_Cbm_MonitorSinkUdp 1
+
+#include "FileDescriptor.hpp"
+#include "MonitorSink.hpp"
+
+#include <string_view>
+#include <utility>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkUdp : public MonitorSink {
+public:
+  MonitorSinkUdp(Monitor& monitor, const string& path);
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+  virtual void ProcessHeartbeat();
+
+protected:
+  MonitorSinkUdp(Monitor& monitor,
+                 const string& path,
+                 const string& cname,
+                 const vector<string>& okeys);
+  void PackLine(string_view line);
+  void SendDatagrams();
+  virtual void AddStatFields(MetricFieldSet& fields);
+
+protected:
+  string fClassName;                         //!< class name for messages
+  FileDescriptor fSockFd{};                  //!< fd of connected UDP socket
+  size_t fMtu;                               //!< max datagram payload size
+  string fBuffer{};                          //!< packed datagram payloads
+  vector<pair<size_t, size_t>> fDatagrams{}; //!< offset,size in fBuffer
+  long fStatNDatagram{0};                    //!< # of sent datagrams
+  long fStatNDrop{0};                        //!< # of dropped datagrams
+  long fStatNDropByte{0};                    //!< # of dropped bytes
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkUdp.ipp"
+
+#endif
@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "MonitorSinkUnix.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "Monitor.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const size_t kChunkSize = 65536; // default chunk (packet) size
+static const size_t kBufSize = 4000000; // default pending buffer limit
+static const double kRetry = 1.;        // default connect retry interval
+static const int kCloseTimeout = 1000;  // max wait for final flush (ms)
+static const size_t kMaxIov = 64;       // max chunks per sendmsg() call
+
+/*! \class MonitorSinkUnix
+  \brief Monitor sink - concrete sink for line format over a Unix socket
+
+  Streams the metrics in InfluxDB line format over a Unix domain socket to
+  a local agent, e.g. the `socket_listener` input of Telegraf. This avoids
+  the overhead of one HTTP request per chunk for the hop to a node-local
+  collector.
+
+  The lines are collected in chunks of at most `chunk` bytes, a line is
+  never split. With a `SOCK_SEQPACKET` socket each chunk is sent as one
+  packet. All writes are non-blocking, chunks which can't be sent are kept
+  in a pending buffer and sent with the next batch or heartbeat. When the
+  pending buffer exceeds `bufsize` the oldest chunks are dropped.
+
+  When the agent is not reachable or closes the connection the sink
+  reconnects, with at most one attempt per `retry` period. After a
+  connection loss in stream mode the partially sent chunk is resent starting
+  with the first line which was not completely written.
+
+  The sink writes periodically some self-monitoring data as Metric to
+  measurement "Monitor" with the fields
+  - `points`: number of metrics in last period
+  - `tags`: total number of tags in all metrics in last period
+  - `fields`: total number of fields in all metrics in last period
+  - `sends`: number of `sendmsg(2)` calls in last period
+  - `bytes`: total number bytes written in last period
+  - `sndtime`: total elapsed time spend in `sendmsg(2)` (in s)
+  - `pending`: bytes in pending buffer
+  - `drops`: number of dropped chunks in last period
+  - `dropbytes`: total number of bytes in dropped chunks in last period
+  - `reconnects`: number of successful connects in last period
+
+  The Metric is tagged with the tags set with SetStatTags().
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param monitor back reference to Monitor
+  \param path    path of the Unix socket, options may follow
+  \throws Exception if `path` is empty or an option is invalid
+
+  The socket path can be followed by `?` and these options
+  - `type`: socket type, `stream` or `seqpacket` (default 'stream')
+  - `chunk`: max size of a chunk in bytes (default '64k'), for `seqpacket`
+    it must fit into the socket send buffer
+  - `bufsize`: limit for the pending buffer in bytes (default '4M')
+  - `retry`: min time between connect attempts in s (default '1')
+
+  The agent does not need to be up when the sink is created, the first
+  connect is tried when the first metrics are sent.
+ */
+
+MonitorSinkUnix::MonitorSinkUnix(Monitor& monitor, const string& path)
+    : MonitorSinkUnix(monitor, path, "MonitorSinkUnix", {}) {}
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor for derived sinks
+  \param monitor back reference to Monitor
+  \param path    path of the Unix socket, options may follow
+  \param cname   class name of concrete sink, used in messages
+  \param okeys   option keys supported by the derived sink, in addition to
+                 `type`, `chunk`, `bufsize` and `retry`
+ */
+
+MonitorSinkUnix::MonitorSinkUnix(Monitor& monitor,
+                                 const string& path,
+                                 const string& cname,
+                                 const vector<string>& okeys)
+    : MonitorSink(monitor, path), fClassName(cname) {
+  vector<string> keys = okeys;
+  keys.insert(keys.end(), {"type", "chunk", "bufsize", "retry"});
+  fOptions.Check(fClassName + "::ctor", keys);
+
+  string stype = fOptions.String("type", "stream");
+  if (stype == "stream") {
+    fSockType = SOCK_STREAM;
+  } else if (stype == "seqpacket") {
+    fSockType = SOCK_SEQPACKET;
+  } else {
+    throw Exception(fmt::format("{}::ctor: type must be stream or seqpacket"
+                                " in '{}'",
+                                fClassName, path));
+  }
+  fChunkSize = fOptions.Size("chunk", kChunkSize);
+  fBufSize = fOptions.Size("bufsize", kBufSize);
+  fRetry = fOptions.Double("retry", kRetry);
+  if (fChunkSize == 0 || fBufSize < fChunkSize)
+    throw Exception(fmt::format("{}::ctor: chunk must be > 0 and not larger"
+                                " than bufsize in '{}'",
+                                fClassName, path));
+
+  sockaddr_un addr{};
+  if (fOptions.Path().empty() ||
+      fOptions.Path().size() >= sizeof(addr.sun_path))
+    throw Exception(fmt::format("{}::ctor: socket path empty or too long"
+                                " in '{}'",
+                                fClassName, path));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor
+
+  Tries to send the pending chunks, waits at most 1 s for the agent. When
+  no socket can be created, e.g. on `EMFILE`, the pending chunks are
+  dropped.
+ */
+
+MonitorSinkUnix::~MonitorSinkUnix() {
+  auto tend = chrono::steady_clock::now() + chrono::milliseconds(kCloseTimeout);
+  while (!Flush() && fSockFd >= 0) {
+    auto tleft = chrono::duration_cast<chrono::milliseconds>(
+        tend - chrono::steady_clock::now());
+    if (tleft.count() <= 0)
+      break;
+    pollfd pfd{fSockFd, POLLOUT, 0};
+    (void)::poll(&pfd, 1, int(tleft.count()));
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process a vector of metrics
+ */
+
+void MonitorSinkUnix::ProcessMetricVec(const vector<Metric>& metvec) {
+  fStatNPoint += metvec.size();
+  string chunk;
+  for (auto& met : metvec) {
+    fStatNTag += met.fTagset.size();
+    fStatNField += met.fFieldset.size();
+    string line = InfluxLine(met) + "\n"s;
+    if (!chunk.empty() && chunk.size() + line.size() > fChunkSize) {
+      QueueChunk(move(chunk));
+      chunk.clear(); // defined state after move
+    }
+    chunk += line;
+  }
+  if (!chunk.empty())
+    QueueChunk(move(chunk));
+  Flush();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Process heartbeat
+
+  Also retries to send pending chunks.
+ */
+
+void MonitorSinkUnix::ProcessHeartbeat() {
+  Flush();
+  MetricFieldSet fields = {{"points", fStatNPoint}, // fields
+                           {"tags", fStatNTag},
+                           {"fields", fStatNField},
+                           {"sends", fStatNSend},
+                           {"bytes", fStatNByte},
+                           {"sndtime", fStatSndTime}, // 'time' not allowed
+                           {"pending", fPendSize},
+                           {"drops", fStatNDrop},
+                           {"dropbytes", fStatNDropByte},
+                           {"reconnects", fStatNReconnect}};
+  AddStatFields(fields);
+  Monitor::Ref().QueueMetric("Monitor", // measurement
+                             fStatTags, // extra tags
+                             move(fields));
+  fStatNPoint = 0;
+  fStatNTag = 0;
+  fStatNField = 0;
+  fStatNSend = 0;
+  fStatNByte = 0;
+  fStatSndTime = 0.;
+  fStatNDrop = 0;
+  fStatNDropByte = 0;
+  fStatNReconnect = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Add a chunk to the pending buffer
+  \param chunk   chunk, one packet in `seqpacket` mode
+
+  When the pending buffer limit is exceeded the oldest chunks are dropped,
+  except a partially sent chunk in stream mode.
+ */
+
+void MonitorSinkUnix::QueueChunk(string&& chunk) {
+  fPendSize += chunk.size();
+  fPending.push_back(move(chunk));
+  while (fPendSize > fBufSize && fPending.size() > 1) {
+    auto it = fFrontOffset > 0 ? fPending.begin() + 1 : fPending.begin();
+    fStatNDrop += 1;
+    fStatNDropByte += it->size();
+    fPendSize -= it->size();
+    fPending.erase(it);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Send pending chunks without blocking
+  \returns `true` if the pending buffer is empty
+
+  A chunk rejected with `EMSGSIZE`, in `seqpacket` mode when it exceeds the
+  packet size limit of the socket, is dropped, the connection is kept.
+ */
+
+bool MonitorSinkUnix::Flush() {
+  if (fPending.empty())
+    return true;
+  if (fSockFd < 0 && !Connect())
+    return false;
+
+  auto tbeg = ScNow();
+  while (!fPending.empty()) {
+    iovec iovs[kMaxIov];
+    size_t niov =
+        fSockType == SOCK_SEQPACKET ? 1 : min(kMaxIov, fPending.size());
+    for (size_t i = 0; i < niov; i++) {
+      string& chunk = fPending[i];
+      size_t offset = i == 0 ? fFrontOffset : 0;
+      iovs[i].iov_base = chunk.data() + offset;
+      iovs[i].iov_len = chunk.size() - offset;
+    }
+    msghdr msg{};
+    msg.msg_iov = iovs;
+    msg.msg_iovlen = niov;
+    ssize_t nsent = ::sendmsg(fSockFd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+    fStatNSend += 1;
+    if (nsent < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EMSGSIZE) { // packet too large, will never fit
+        string& front = fPending.front();
+        fStatNDrop += 1;
+        fStatNDropByte += front.size();
+        fPendSize -= front.size();
+        fPending.pop_front();
+        fFrontOffset = 0;
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        Disconnect(errno);
+      break;
+    }
+
+    // consume sent data from pending buffer
+    fStatNByte += nsent;
+    size_t nrest = size_t(nsent);
+    while (nrest > 0) {
+      size_t nfront = fPending.front().size() - fFrontOffset;
+      if (nrest < nfront) {
+        fFrontOffset += nrest;
+        break;
+      }
+      nrest -= nfront;
+      fPendSize -= fPending.front().size();
+      fPending.pop_front();
+      fFrontOffset = 0;
+    }
+  }
+  fStatSndTime += ScTimeDiff2Double(tbeg, ScNow());
+  return fPending.empty();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Connect to the agent
+  \returns `true` if connected
+
+  A connect is only attempted when the `retry` period since the last failed
+  attempt has passed. A failure to create the socket, e.g. on `EMFILE`, is
+  handled like a failed connect. The first failure after a successful
+  connect is reported, later ones are silent.
+ */
+
+bool MonitorSinkUnix::Connect() {
+  auto now = ScNow();
+  if (now < fNextConnect)
+    return false;
+  fNextConnect =
+      now + chrono::duration_cast<scduration>(chrono::duration<double>(fRetry));
+
+  const char* what = "socket";
+  int fd = ::socket(AF_UNIX, fSockType | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd >= 0) {
+    fSockFd.Set(fd);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    fOptions.Path().copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    // a non-blocking connect of a Unix socket completes or fails immediately
+    what = "connect";
+    if (::connect(fSockFd, reinterpret_cast<sockaddr*>(&addr),
+                  sizeof(addr)) == 0) {
+      fConnLogged = false;
+      fStatNReconnect += 1;
+      return true;
+    }
+  }
+
+  int eno = errno;
+  fSockFd.Close();
+  if (!fConnLogged) {
+    fConnLogged = true;
+#if defined(CBMLOGERR1)
+    CBMLOGERR1("cid=__Monitor", "SendData-err")
+        << "sinkname=" << fSinkPath << ", " << what
+        << " error=" << ::strerror(eno);
+#else
+    std::cerr << fClassName << "::Connect error: "
+              << "sinkname=" << fSinkPath << ", " << what
+              << " error=" << ::strerror(eno) << "\n";
+#endif
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Close connection after a send error
+  \param eno   errno of the failed send
+
+  In stream mode a partially sent front chunk is trimmed as determined by
+  ResendTrim(), the remainder is resent after reconnect.
+ */
+
+void MonitorSinkUnix::Disconnect(int eno) {
+  fSockFd.Close();
+  if (fFrontOffset > 0) {
+    string& front = fPending.front();
+    size_t ntrim = ResendTrim(front, fFrontOffset);
+    front.erase(0, ntrim);
+    fPendSize -= ntrim;
+    fFrontOffset = 0;
+  }
+#if defined(CBMLOGERR1)
+  CBMLOGERR1("cid=__Monitor", "SendData-err")
+      << "sinkname=" << fSinkPath << ", error=" << ::strerror(eno);
+#else
+  std::cerr << fClassName << "::Flush error: "
+            << "sinkname=" << fSinkPath << ", error=" << ::strerror(eno)
+            << "\n";
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns number of bytes of a partially sent chunk not to resend
+  \param chunk   the partially sent chunk
+  \param nsent   number of bytes of `chunk` already sent
+
+  The default drops all completely sent lines, so the resend starts with
+  the first line which was not completely sent. Derived sinks with other
+  chunk formats override this.
+ */
+
+size_t MonitorSinkUnix::ResendTrim(const string& chunk, size_t nsent) {
+  size_t pos = chunk.rfind('\n', nsent - 1);
+  return pos == string::npos ? 0 : pos + 1;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Hook for derived sinks to add fields to the self-monitoring metric
+ */
+
+void MonitorSinkUnix::AddStatFields(MetricFieldSet&) {}
+
+} // end namespace cbm
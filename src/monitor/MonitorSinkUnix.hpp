@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MonitorSinkUnix
+#define included_Cbm_MonitorSinkUnix 1
+
+#include "ChronoDefs.hpp"
+#include "FileDescriptor.hpp"
+#include "MonitorSink.hpp"
+
+#include <deque>
+
+namespace cbm {
+using namespace std;
+
+class MonitorSinkUnix : public MonitorSink {
+public:
+  MonitorSinkUnix(Monitor& monitor, const string& path);
+  virtual ~MonitorSinkUnix();
+
+  virtual void ProcessMetricVec(const vector<Metric>& metvec);
+  virtual void ProcessHeartbeat();
+
+protected:
+  MonitorSinkUnix(Monitor& monitor,
+                  const string& path,
+                  const string& cname,
+                  const vector<string>& okeys);
+  void QueueChunk(string&& chunk);
+  bool Flush();
+  bool Connect();
+  void Disconnect(int eno);
+  virtual size_t ResendTrim(const string& chunk, size_t nsent);
+  virtual void AddStatFields(MetricFieldSet& fields);
+
+protected:
+  string fClassName;           //!< class name for messages
+  int fSockType;               //!< SOCK_STREAM or SOCK_SEQPACKET
+  FileDescriptor fSockFd{};    //!< fd of socket, -1 if not connected
+  size_t fChunkSize;           //!< max size of a chunk (packet)
+  size_t fBufSize;             //!< limit for fPendSize
+  double fRetry;               //!< min time between connect attempts (in s)
+  sctime_point fNextConnect{}; //!< earliest time for next connect attempt
+  deque<string> fPending{};    //!< chunks waiting for send
+  size_t fPendSize{0};         //!< total size of chunks in fPending
+  size_t fFrontOffset{0};      //!< bytes of front chunk already sent
+  bool fConnLogged{false};     //!< connect failure already reported
+  long fStatNDrop{0};          //!< # of dropped chunks
+  long fStatNDropByte{0};      //!< # of dropped bytes
+  long fStatNReconnect{0};     //!< # of successful connects
+};
+
+} // end namespace cbm
+
+//#include "MonitorSinkUnix.ipp"
+
+#endif
@@ -6,6 +6,9 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include <stdio.h>
 #include <time.h>
 
@@ -26,21 +29,65 @@ using namespace std;
 
   Converts `tpoint` into an [ISO 8601](https://en.wikipedia.org/wiki/ISO_8601)
   format string with micro second precision like `YYYY-MM-DDTHH:MM:SS.ssssss`.
+  See AppendTimePoint() for details.
 */
 
 string TimePoint2String(const sctime_point& tpoint) {
-  // get the date/time part up to the seconds level
-  time_t tp_tt = chrono::system_clock::to_time_t(tpoint);
-  tm tp_tm = {};
-  (void)::localtime_r(&tp_tt, &tp_tm);
-  // get fractional seconds part at microseconds precision
+  string res;
+  AppendTimePoint(res, tpoint);
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*!
+  \ingroup ChronoHelper
+  \brief Append the ISO 8601 representation of a chrono time_point
+  \param str     string to which the representation is appended
+  \param tpoint  chrono time_point
+
+  Appends `tpoint` in the format of TimePoint2String() to `str`, without
+  allocation when `str` has sufficient capacity.
+
+  The date/time part up to the second is obtained with `localtime_r(3)`,
+  which is costly and might take a global lock for the timezone. It is
+  therefore cached per thread and only recomputed when the second changes,
+  for a burst of messages only the microsecond digits are formatted.
+*/
+
+void AppendTimePoint(string& str, const sctime_point& tpoint) {
+  struct Cache {
+    int64_t fSec{INT64_MIN}; //!< cached second since epoch
+    char fPrefix[32]{};      //!< `YYYY-MM-DDTHH:MM:SS.` for fSec
+    size_t fSize{0};         //!< length of fPrefix
+  };
+  static thread_local Cache cache;
+
   auto tp_dur = tpoint.time_since_epoch();
-  auto tp_sec = chrono::duration_cast<chrono::seconds>(tp_dur);
+  auto tp_sec = chrono::floor<chrono::seconds>(tp_dur);
+  if (tp_sec.count() != cache.fSec) {
+    // get the date/time part up to the seconds level
+    time_t tp_tt = time_t(tp_sec.count());
+    tm tp_tm = {};
+    (void)::localtime_r(&tp_tt, &tp_tm);
+    auto res = fmt::format_to_n(cache.fPrefix, sizeof(cache.fPrefix),
+                                "{:4d}-{:02d}-{:02d}T{:02d}:{:02d}:{:02d}.",
+                                tp_tm.tm_year + 1900, tp_tm.tm_mon + 1,
+                                tp_tm.tm_mday, tp_tm.tm_hour, tp_tm.tm_min,
+                                tp_tm.tm_sec);
+    cache.fSize = min(res.size, sizeof(cache.fPrefix));
+    cache.fSec = tp_sec.count();
+  }
+
+  // get fractional seconds part at microseconds precision
   auto tp_usec = chrono::duration_cast<chrono::microseconds>(tp_dur - tp_sec);
-  return fmt::format("{:4d}-{:02d}-{:02d}T{:02d}:{:02d}:{:02d}.{:06d}",
-                     tp_tm.tm_year + 1900, tp_tm.tm_mon + 1, tp_tm.tm_mday,
-                     tp_tm.tm_hour, tp_tm.tm_min, tp_tm.tm_sec,
-                     int(tp_usec.count()));
+  int usec = int(tp_usec.count());
+  char digits[6];
+  for (int i = 5; i >= 0; i--) {
+    digits[i] = char('0' + usec % 10);
+    usec /= 10;
+  }
+  str.append(cache.fPrefix, cache.fSize);
+  str.append(digits, sizeof(digits));
 }
 
 } // end namespace cbm
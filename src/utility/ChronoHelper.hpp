@@ -9,12 +9,16 @@
 
 #include <string>
 
+#include <time.h>
+
 namespace cbm {
 using namespace std;
 
 sctime_point ScNow();
+sctime_point ScNowCoarse();
 
 string TimePoint2String(const sctime_point& time);
+void AppendTimePoint(string& str, const sctime_point& time);
 string TimeStamp();
 
 long ScDuration2Msec(const scduration& dur);
@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "CrashHandler.hpp"
+
+#include "Exception.hpp"
+#include "SysCallException.hpp"
+
+#include <cstring>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const int kSignals[CrashHandler::kNSignal] = {SIGSEGV, SIGBUS, SIGFPE,
+                                                     SIGILL, SIGABRT};
+static const char* const kSigNames[CrashHandler::kNSignal] = {
+    "SIGSEGV", "SIGBUS", "SIGFPE", "SIGILL", "SIGABRT"};
+
+/*! \class CrashBuffer
+  \brief Async-signal-safe line buffer for CrashHandler hooks
+
+  Collects text in a fixed size buffer and writes it with `write(2)` when
+  full or on Flush(). The conversions only use arithmetic, so all methods
+  can be used in a signal handler.
+*/
+
+//-----------------------------------------------------------------------------
+//! \brief Sets the output fd
+
+void CrashBuffer::SetFd(int fd) { fFd = fd; }
+
+//-----------------------------------------------------------------------------
+//! \brief Appends a string, flushes when the buffer is full
+
+void CrashBuffer::Append(string_view str) {
+  while (!str.empty()) {
+    if (fSize == sizeof(fBuf))
+      Flush();
+    size_t nbyte = min(str.size(), sizeof(fBuf) - fSize);
+    memcpy(fBuf + fSize, str.data(), nbyte);
+    fSize += nbyte;
+    str.remove_prefix(nbyte);
+  }
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Appends a character
+
+void CrashBuffer::Append(char chr) { Append(string_view(&chr, 1)); }
+
+//-----------------------------------------------------------------------------
+//! \brief Appends a signed integer in decimal
+
+void CrashBuffer::AppendInt(int64_t val) {
+  if (val < 0) {
+    Append('-');
+    AppendUInt(uint64_t(0) - uint64_t(val));
+  } else {
+    AppendUInt(uint64_t(val));
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Appends an unsigned integer in decimal
+  \param val     value
+  \param width   minimal number of digits, padded with leading zeros
+ */
+
+void CrashBuffer::AppendUInt(uint64_t val, int width) {
+  char digits[20];
+  int ndig = 0;
+  do {
+    digits[sizeof(digits) - 1 - ndig++] = char('0' + val % 10);
+    val /= 10;
+  } while (val > 0);
+  while (ndig < width && ndig < int(sizeof(digits)))
+    digits[sizeof(digits) - 1 - ndig++] = '0';
+  Append(string_view(digits + sizeof(digits) - ndig, size_t(ndig)));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Appends a floating point value
+
+  Uses a fixed point format with up to 6 fractional digits, and an
+  exponent format with 6 digits for very small or large values. The last
+  digit might be off, this is good enough for a crash report.
+ */
+
+void CrashBuffer::AppendDouble(double val) {
+  if (val != val) {
+    Append("nan");
+    return;
+  }
+  if (val < 0.) {
+    Append('-');
+    val = -val;
+  }
+  if (val > 1.e308) {
+    Append("inf");
+    return;
+  }
+  int exp = 0;
+  if (val != 0. && (val < 1.e-4 || val >= 1.e15)) {
+    while (val >= 10.) {
+      val /= 10.;
+      exp += 1;
+    }
+    while (val < 1.) {
+      val *= 10.;
+      exp -= 1;
+    }
+  }
+  uint64_t ival = uint64_t(val);
+  uint64_t frac = uint64_t((val - double(ival)) * 1.e6 + 0.5);
+  if (frac >= 1000000) {
+    ival += 1;
+    frac -= 1000000;
+  }
+  AppendUInt(ival);
+  if (frac > 0) {
+    int width = 6;
+    while (frac % 10 == 0) {
+      frac /= 10;
+      width -= 1;
+    }
+    Append('.');
+    AppendUInt(frac, width);
+  }
+  if (exp != 0) {
+    Append('e');
+    AppendInt(exp);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Appends a time point as ISO 8601 UTC time
+
+  The format is `YYYY-MM-DDTHH:MM:SS.ssssssZ`. `localtime_r(3)` is not
+  async-signal-safe, the conversion is therefore done for UTC, with the
+  days to civil date algorithm of H. Hinnant.
+ */
+
+void CrashBuffer::AppendTime(const sctime_point& time) {
+  int64_t usec =
+      chrono::duration_cast<chrono::microseconds>(time.time_since_epoch())
+          .count();
+  int64_t sec = usec >= 0 ? usec / 1000000 : (usec - 999999) / 1000000;
+  usec -= sec * 1000000;
+  int64_t days = sec >= 0 ? sec / 86400 : (sec - 86399) / 86400;
+  int64_t sod = sec - days * 86400;
+
+  int64_t z = days + 719468;
+  int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  int64_t doe = z - era * 146097;
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t mp = (5 * doy + 2) / 153;
+  int64_t day = doy - (153 * mp + 2) / 5 + 1;
+  int64_t month = mp < 10 ? mp + 3 : mp - 9;
+  int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+  AppendUInt(uint64_t(year), 4);
+  Append('-');
+  AppendUInt(uint64_t(month), 2);
+  Append('-');
+  AppendUInt(uint64_t(day), 2);
+  Append('T');
+  AppendUInt(uint64_t(sod / 3600), 2);
+  Append(':');
+  AppendUInt(uint64_t(sod / 60 % 60), 2);
+  Append(':');
+  AppendUInt(uint64_t(sod % 60), 2);
+  Append('.');
+  AppendUInt(uint64_t(usec), 6);
+  Append('Z');
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Writes the buffer content, errors are ignored
+
+void CrashBuffer::Flush() {
+  size_t nwrite = 0;
+  while (nwrite < fSize) {
+    ssize_t rc = ::write(fFd, fBuf + nwrite, fSize - nwrite);
+    if (rc < 0 && errno == EINTR)
+      continue;
+    if (rc <= 0)
+      break;
+    nwrite += size_t(rc);
+  }
+  fSize = 0;
+}
+
+/*! \class CrashHandler
+  \brief Emergency flush of queued Logger and Monitor data on fatal signals
+
+  When a process dies by a fatal signal the messages and metrics still
+  queued in Logger and Monitor are lost, often including the ones which
+  explain the crash. The CrashHandler is an opt-in handler for `SIGSEGV`,
+  `SIGBUS`, `SIGFPE`, `SIGILL` and `SIGABRT`, which writes them to a file
+  before the process terminates.
+
+  Install() opens the file and installs the signal handler. Logger and
+  Monitor register a hook with AddHook() when they are created, and remove
+  it with RemoveHook() when destroyed. On a fatal signal the handler
+  - writes a header line with the signal number and name
+  - calls all hooks, which format the queued items into a CrashBuffer
+  - restores the previous signal action and re-raises the signal, so the
+    process terminates as without CrashHandler, e.g. with a core dump.
+    When the previous action is a handler which returns, the process
+    continues and the hooks have released all threads they stopped.
+
+  Only async-signal-safe operations are used: the file is opened and the
+  buffer allocated in advance, text is formatted by CrashBuffer without
+  `fmt` or `stdio`, and output is done with `write(2)`. When a second
+  thread crashes while the first one flushes it waits, the first one then
+  terminates the process.
+
+  An alternate signal stack is set up for the thread calling Install(),
+  so a stack overflow in this thread is handled too. Other threads use
+  their normal stack.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Installs the signal handler
+  \param path   name of output file, data is appended
+  \throws Exception if already installed
+  \throws SysCallException if the file can't be opened
+ */
+
+void CrashHandler::Install(const string& path) {
+  if (fFd >= 0)
+    throw Exception("CrashHandler::Install: already installed");
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                  0644);
+  if (fd < 0)
+    throw SysCallException("CrashHandler::Install"s, "open"s, path, errno);
+  fFd = fd;
+  fBuffer.SetFd(fd);
+
+  stack_t altstack{};
+  altstack.ss_sp = fAltStack;
+  altstack.ss_size = sizeof(fAltStack);
+  if (::sigaltstack(&altstack, nullptr) < 0)
+    throw SysCallException("CrashHandler::Install"s, "sigaltstack"s, errno);
+
+  struct sigaction action {};
+  action.sa_sigaction = &CrashHandler::Handler;
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  for (size_t i = 0; i < kNSignal; i++) {
+    if (::sigaction(kSignals[i], &action, &fOldActions[i]) < 0)
+      throw SysCallException("CrashHandler::Install"s, "sigaction"s, errno);
+  }
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` if the signal handler is installed
+
+bool CrashHandler::Installed() { return fFd >= 0; }
+
+//-----------------------------------------------------------------------------
+/*! \brief Registers a hook called by the signal handler
+  \param hook   hook function
+  \param ctx    context passed to `hook`, also identifies it
+  \throws Exception if all kNHook slots are in use
+ */
+
+void CrashHandler::AddHook(hook_t hook, void* ctx) {
+  for (size_t i = 0; i < kNHook; i++) {
+    void* exp = nullptr;
+    if (fCtxs[i].compare_exchange_strong(exp, ctx)) {
+      fHooks[i].store(hook);
+      return;
+    }
+  }
+  throw Exception("CrashHandler::AddHook: too many hooks");
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Removes the hook registered with context `ctx`
+ */
+
+void CrashHandler::RemoveHook(void* ctx) {
+  for (size_t i = 0; i < kNHook; i++) {
+    if (fCtxs[i].load() == ctx) {
+      fHooks[i].store(nullptr);
+      fCtxs[i].store(nullptr);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief The signal handler
+ */
+
+void CrashHandler::Handler(int sig, siginfo_t*, void*) {
+  if (fActive.exchange(true)) { // another thread is flushing
+    while (true)
+      ::pause();
+  }
+
+  size_t isig = 0;
+  while (isig < kNSignal - 1 && kSignals[isig] != sig)
+    isig += 1;
+
+  fBuffer.Append("CrashHandler: ");
+  fBuffer.AppendTime(chrono::system_clock::now());
+  fBuffer.Append(": pid ");
+  fBuffer.AppendInt(::getpid());
+  fBuffer.Append(" got signal ");
+  fBuffer.AppendInt(sig);
+  fBuffer.Append(" (");
+  fBuffer.Append(kSigNames[isig]);
+  fBuffer.Append("), flushing queues\n");
+  for (size_t i = 0; i < kNHook; i++) {
+    hook_t hook = fHooks[i].load();
+    void* ctx = fCtxs[i].load();
+    if (hook && ctx)
+      (*hook)(ctx, fBuffer);
+  }
+  fBuffer.Append("CrashHandler: done\n");
+  fBuffer.Flush();
+
+  // the signal is blocked in the handler, it is delivered after return
+  (void)::sigaction(sig, &fOldActions[isig], nullptr);
+  (void)::raise(sig);
+  fActive.store(false); // previous action may return, handle later signals
+}
+
+//-----------------------------------------------------------------------------
+// define static member variables
+
+int CrashHandler::fFd = -1;
+atomic<bool> CrashHandler::fActive{false};
+atomic<CrashHandler::hook_t> CrashHandler::fHooks[kNHook] = {};
+atomic<void*> CrashHandler::fCtxs[kNHook] = {};
+struct sigaction CrashHandler::fOldActions[kNSignal] = {};
+CrashBuffer CrashHandler::fBuffer;
+char CrashHandler::fAltStack[kAltStack];
+
+} // end namespace cbm
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_CrashHandler
+#define included_Cbm_CrashHandler 1
+
+#include "ChronoDefs.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <signal.h>
+
+namespace cbm {
+using namespace std;
+
+class CrashBuffer {
+public:
+  CrashBuffer() = default;
+
+  CrashBuffer(const CrashBuffer&) = delete;
+  CrashBuffer& operator=(const CrashBuffer&) = delete;
+
+  void SetFd(int fd);
+  void Append(string_view str);
+  void Append(char chr);
+  void AppendInt(int64_t val);
+  void AppendUInt(uint64_t val, int width = 0);
+  void AppendDouble(double val);
+  void AppendTime(const sctime_point& time);
+  void Flush();
+
+private:
+  int fFd{-1};        //!< output fd
+  size_t fSize{0};    //!< used bytes in fBuf
+  char fBuf[16384]{}; //!< line buffer
+};
+
+class CrashHandler {
+public:
+  using hook_t = void (*)(void* ctx, CrashBuffer& buf);
+
+  static void Install(const string& path);
+  static bool Installed();
+  static void AddHook(hook_t hook, void* ctx);
+  static void RemoveHook(void* ctx);
+
+  // some constants
+  static const size_t kNHook = 8;        //!< max # of registered hooks
+  static const size_t kNSignal = 5;      //!< # of handled signals
+  static const size_t kAltStack = 65536; //!< size of alternate stack
+
+private:
+  static void Handler(int sig, siginfo_t* info, void* uctx);
+
+private:
+  static int fFd;                                //!< pre-opened output fd
+  static atomic<bool> fActive;                   //!< set by first handler call
+  static atomic<hook_t> fHooks[kNHook];          //!< registered hooks
+  static atomic<void*> fCtxs[kNHook];            //!< context of hooks
+  static struct sigaction fOldActions[kNSignal]; //!< saved signal actions
+  static CrashBuffer fBuffer;                    //!< pre-allocated line buffer
+  static char fAltStack[kAltStack];              //!< alternate signal stack
+};
+
+} // end namespace cbm
+
+//#include "CrashHandler.ipp"
+
+#endif
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "FileUring.hpp"
+
+#include "SysCallException.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cbm {
+using namespace std;
+
+/*! \class FileUring
+  \brief Minimal io_uring instance for asynchronous file writes
+
+  Provides just what FileWriter needs for its asynchronous backend: queue
+  `writev` requests with PrepWrite(), hand them to the kernel with Submit()
+  and collect the results with Reap(). The io_uring system calls are used
+  directly, so no liburing is needed.
+
+  The caller must keep the number of requests in flight at most Depth()
+  and keep the iovec and the data valid until the request was reaped.
+
+  The constructor throws when io_uring is not available, e.g. on kernels
+  older than 5.1, or when it is disabled by a seccomp filter or the
+  `kernel.io_uring_disabled` sysctl. The caller should then fall back to
+  plain writes.
+ */
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor, sets up the rings
+  \param depth   number of submission queue entries
+  \throws SysCallException if io_uring is not available
+ */
+
+FileUring::FileUring(unsigned depth) {
+  io_uring_params params{};
+  int fd = int(::syscall(__NR_io_uring_setup, depth, &params));
+  if (fd < 0)
+    throw SysCallException("FileUring::ctor"s, "io_uring_setup"s, errno);
+  fFd.Set(fd);
+  fDepth = params.sq_entries;
+
+  fSqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  fCqMapSize =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single)
+    fSqMapSize = fCqMapSize = max(fSqMapSize, fCqMapSize);
+
+  auto map = [this](size_t size, off_t offset) {
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fFd, offset);
+    if (addr == MAP_FAILED)
+      throw SysCallException("FileUring::ctor"s, "mmap"s, errno);
+    return addr;
+  };
+  fpSqMap = map(fSqMapSize, IORING_OFF_SQ_RING);
+  if (single) {
+    fpCqMap = fpSqMap;
+  } else {
+    try {
+      fpCqMap = map(fCqMapSize, IORING_OFF_CQ_RING);
+    } catch (...) {
+      (void)::munmap(fpSqMap, fSqMapSize);
+      throw;
+    }
+  }
+  fSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  try {
+    fpSqes = static_cast<io_uring_sqe*>(map(fSqesSize, IORING_OFF_SQES));
+  } catch (...) {
+    if (!single)
+      (void)::munmap(fpCqMap, fCqMapSize);
+    (void)::munmap(fpSqMap, fSqMapSize);
+    throw;
+  }
+
+  auto sq = static_cast<char*>(fpSqMap);
+  auto cq = static_cast<char*>(fpCqMap);
+  fpSqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  fpSqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  fSqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  fpCqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  fpCqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  fpCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+  fCqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor, unmaps the rings
+
+  The caller must have reaped all requests before.
+ */
+
+FileUring::~FileUring() {
+  (void)::munmap(fpSqes, fSqesSize);
+  if (fpCqMap != fpSqMap)
+    (void)::munmap(fpCqMap, fCqMapSize);
+  (void)::munmap(fpSqMap, fSqMapSize);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Queue a write request, it is passed to the kernel by Submit()
+  \param fd      file descriptor
+  \param iov     data to write, must stay valid until reaped
+  \param offset  file offset
+  \param tag     returned by Reap() for this request
+ */
+
+void FileUring::PrepWrite(int fd,
+                          const iovec* iov,
+                          uint64_t offset,
+                          uint64_t tag) {
+  unsigned tail = *fpSqTail; // only written by this side
+  unsigned idx = tail & fSqMask;
+  io_uring_sqe& sqe = fpSqes[idx];
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_WRITEV;
+  sqe.fd = fd;
+  sqe.addr = reinterpret_cast<uint64_t>(iov);
+  sqe.len = 1;
+  sqe.off = offset;
+  sqe.user_data = tag;
+  fpSqArray[idx] = idx;
+  __atomic_store_n(fpSqTail, tail + 1, __ATOMIC_RELEASE);
+  fNPrepared += 1;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Submit all prepared requests
+  \throws SysCallException if io_uring_enter fails
+ */
+
+void FileUring::Submit() {
+  while (fNPrepared > 0) {
+    int nsub = Enter(fNPrepared, 0, 0);
+    fNPrepared -= unsigned(nsub);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Get the result of a completed request
+  \param tag    returns the tag given to PrepWrite()
+  \param res    returns the result, bytes written or negative errno
+  \param wait   if `true` wait until a request completes
+  \returns `false` if no request completed and `wait` is `false`
+  \throws SysCallException if io_uring_enter fails
+ */
+
+bool FileUring::Reap(uint64_t& tag, int& res, bool wait) {
+  while (true) {
+    unsigned head = *fpCqHead; // only written by this side
+    unsigned tail = __atomic_load_n(fpCqTail, __ATOMIC_ACQUIRE);
+    if (head != tail) {
+      const io_uring_cqe& cqe = fpCqes[head & fCqMask];
+      tag = cqe.user_data;
+      res = cqe.res;
+      __atomic_store_n(fpCqHead, head + 1, __ATOMIC_RELEASE);
+      return true;
+    }
+    if (!wait)
+      return false;
+    Enter(0, 1, IORING_ENTER_GETEVENTS);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Wrapper for the io_uring_enter system call, retries on EINTR
+ */
+
+int FileUring::Enter(unsigned nsubmit, unsigned nwait, unsigned flags) {
+  while (true) {
+    int rc = int(::syscall(__NR_io_uring_enter, int(fFd), nsubmit, nwait,
+                           flags, nullptr, 0));
+    if (rc >= 0)
+      return rc;
+    if (errno != EINTR)
+      throw SysCallException("FileUring::Enter"s, "io_uring_enter"s, errno);
+  }
+}
+
+} // end namespace cbm
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_FileUring
+#define included_Cbm_FileUring 1
+
+#include "FileDescriptor.hpp"
+
+#include <cstdint>
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+namespace cbm {
+using namespace std;
+
+class FileUring {
+public:
+  explicit FileUring(unsigned depth);
+  virtual ~FileUring();
+
+  FileUring(const FileUring&) = delete;
+  FileUring& operator=(const FileUring&) = delete;
+
+  unsigned Depth() const;
+  void PrepWrite(int fd, const iovec* iov, uint64_t offset, uint64_t tag);
+  void Submit();
+  bool Reap(uint64_t& tag, int& res, bool wait);
+
+private:
+  int Enter(unsigned nsubmit, unsigned nwait, unsigned flags);
+
+private:
+  FileDescriptor fFd{};          //!< io_uring fd
+  unsigned fDepth{0};            //!< # of submission queue entries
+  void* fpSqMap{nullptr};        //!< mapping of submission ring
+  size_t fSqMapSize{0};          //!< size of fpSqMap mapping
+  void* fpCqMap{nullptr};        //!< mapping of completion ring
+  size_t fCqMapSize{0};          //!< size of fpCqMap mapping
+  io_uring_sqe* fpSqes{nullptr}; //!< mapping of submission entries
+  size_t fSqesSize{0};           //!< size of fpSqes mapping
+  unsigned* fpSqTail{nullptr};   //!< submission ring tail
+  unsigned* fpSqArray{nullptr};  //!< submission ring index array
+  unsigned fSqMask{0};           //!< submission ring mask
+  unsigned* fpCqHead{nullptr};   //!< completion ring head
+  unsigned* fpCqTail{nullptr};   //!< completion ring tail
+  io_uring_cqe* fpCqes{nullptr}; //!< completion entries
+  unsigned fCqMask{0};           //!< completion ring mask
+  unsigned fNPrepared{0};        //!< # of entries prepared, not submitted
+};
+
+} // end namespace cbm
+
+#include "FileUring.ipp"
+
+#endif
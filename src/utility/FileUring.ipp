@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the number of submission queue entries
+
+inline unsigned FileUring::Depth() const { return fDepth; }
+
+} // end namespace cbm
@@ -0,0 +1,586 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "FileWriter.hpp"
+
+#include "ChronoHelper.hpp"
+#include "Exception.hpp"
+#include "PThreadHelper.hpp"
+#include "SinkOptions.hpp"
+#include "SysCallException.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace cbm {
+using namespace std;
+// some constants
+static const size_t kCompressChunk = 262144; // read size for compression
+static const long kIoDepth = 8;              // default io_uring depth
+
+const vector<string> FileWriter::kOptionKeys = {
+    "rotsize", "rotint", "keep", "compress", "io", "iodepth"};
+
+/*! \class FileWriter
+  \brief Buffered writer on a raw file descriptor
+
+  Collects the data in a user-space buffer and writes it with as few system
+  calls as possible: the buffer is written when it is full or on Flush().
+  Data which doesn't fit into the buffer anymore is written together with
+  the buffer content in one `writev(2)` call without being copied. Used by
+  the file sinks of Monitor and Logger instead of an `ofstream`.
+
+  The special names `cout` and `cerr` write to the standard output and error
+  file descriptors, in all other cases a file is created, or truncated if it
+  exists.
+
+  The time spend in each write and sync call is measured, see Statistics().
+
+  Optionally the data is written asynchronously with io_uring, see
+  Configure(). A full buffer is then handed to the kernel as write request
+  and the caller continues with a fresh buffer, so a slow disk doesn't
+  stall it as long as fewer than `iodepth` requests are in flight. The
+  requests carry the file offset, so their completion order doesn't matter.
+  The time measured as write time is then the time spend in submission and
+  in waiting for a free request slot.
+
+  Files can be rotated by size or periodically, see Configure(). The file
+  is renamed to `<name>.<yyyymmdd-hhmmss>`, with the local time of the
+  rotation, and a new file `<name>` is opened. Writes are never split, each
+  Write() ends up completely in one file. The rotated files are compressed
+  with gzip and the oldest ones are removed by a background thread which
+  runs with the `SCHED_IDLE` policy, so only the rename and the open are
+  done in the thread calling Write() or Flush(). When the FileWriter is
+  destroyed, rotated files not yet compressed are left uncompressed, so
+  closing a sink never waits for the compression backlog.
+ */
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param fname    file name, or `cout` or `cerr`
+  \param bufsize  buffer size in bytes
+  \throws SysCallException if the file can't be opened
+ */
+
+FileWriter::FileWriter(const string& fname, size_t bufsize)
+    : fName(fname), fBufSize(max(bufsize, size_t(1))) {
+  if (fname == "cout"s) {
+    fFd.Set(STDOUT_FILENO);
+  } else if (fname == "cerr"s) {
+    fFd.Set(STDERR_FILENO);
+  } else {
+    OpenFile();
+  }
+  fBuffer.reserve(fBufSize);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Destructor, writes the buffered data
+
+  Write errors are ignored at this point. Rotated files still queued for
+  compression stay uncompressed, see StopCompressor().
+ */
+
+FileWriter::~FileWriter() {
+  try {
+    WriteBuffer();
+    Drain();
+  } catch (...) {
+  }
+  StopCompressor();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Setup output backend and rotation from sink options
+  \param opts   sink options
+  \throws Exception if an option is invalid or rotation is requested for
+    `cout` or `cerr`
+
+  The backend is selected with
+  - `io`: `sync` for plain `writev(2)` (default), or `uring` for
+    asynchronous writes with io_uring. When io_uring is not available, and
+    always for `cout` and `cerr`, plain writes are used, see Async()
+  - `iodepth`: max number of write requests in flight (default '8')
+
+  These options control the rotation, it is off when neither `rotsize` nor
+  `rotint` is given
+  - `rotsize`: rotate when the file would exceed this size in bytes
+  - `rotint`: rotate periodically, every `rotint` seconds. The rotations are
+    aligned to the wall-clock, e.g. `3600` rotates at each full hour
+  - `keep`: number of rotated files to keep (default '0', keeps all)
+  - `compress`: `gzip` (default) or `none`
+
+  The option keys are available as kOptionKeys for SinkOptions::Check().
+ */
+
+void FileWriter::Configure(const SinkOptions& opts) {
+  fRotSize = opts.Size("rotsize", 0);
+  fRotPeriod = opts.Double("rotint", 0.);
+  fKeep = opts.Long("keep", 0);
+  string scomp = opts.String("compress", "gzip");
+  if (scomp != "gzip" && scomp != "none")
+    throw Exception(fmt::format("FileWriter::Configure: compress must be"
+                                " gzip or none for '{}'",
+                                fName));
+  fCompress = scomp == "gzip";
+  if (fRotPeriod < 0. || fKeep < 0)
+    throw Exception(fmt::format("FileWriter::Configure: rotint and keep"
+                                " must not be negative for '{}'",
+                                fName));
+  if ((fRotSize > 0 || fRotPeriod > 0.) && fFd <= STDERR_FILENO)
+    throw Exception(fmt::format("FileWriter::Configure: can't rotate '{}'",
+                                fName));
+  if (fRotPeriod > 0.)
+    ScheduleRotation();
+
+  string sio = opts.String("io", "sync");
+  long depth = opts.Long("iodepth", kIoDepth);
+  if ((sio != "sync" && sio != "uring") || depth < 1)
+    throw Exception(fmt::format("FileWriter::Configure: io must be sync or"
+                                " uring and iodepth >= 1 for '{}'",
+                                fName));
+  if (sio == "uring" && fFd > STDERR_FILENO && !fpUring) {
+    try {
+      fpUring = make_unique<FileUring>(unsigned(depth));
+      fSlots.resize(min(size_t(depth), size_t(fpUring->Depth())));
+    } catch (const SysCallException&) {
+      // io_uring not available, stay with plain writes
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Buffered write of `data`
+  \throws SysCallException if the write fails, the buffered data is dropped
+ */
+
+void FileWriter::Write(string_view data) {
+  if (fRotSize > 0 && fFileSize + fBuffer.size() > 0 &&
+      fFileSize + fBuffer.size() + data.size() > fRotSize)
+    Rotate();
+  if (fBuffer.size() + data.size() <= fBufSize) {
+    fBuffer.append(data);
+    return;
+  }
+  if (fpUring) { // submit buffer, large data gets its own request
+    SubmitBuffer();
+    fBuffer.append(data);
+    if (fBuffer.size() > fBufSize)
+      SubmitBuffer();
+    return;
+  }
+  iovec iovs[2] = {{fBuffer.data(), fBuffer.size()},
+                   {const_cast<char*>(data.data()), data.size()}};
+  WriteIov(iovs, 2);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Writes the buffered data
+  \throws SysCallException if the write fails, the buffered data is dropped
+
+  Also does a periodic rotation when it is due.
+ */
+
+void FileWriter::Flush() {
+  if (fRotPeriod > 0. && ScNow() >= fNextRotate) {
+    if (fFileSize + fBuffer.size() > 0)
+      Rotate();
+    ScheduleRotation();
+  }
+  WriteBuffer();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Writes the buffered data and commits it to disk with `fdatasync`
+  \throws SysCallException if the write or sync fails
+
+  For `cout` and `cerr` only the write is done, and also when the file
+  doesn't support a sync, like a pipe.
+ */
+
+void FileWriter::Sync() {
+  WriteBuffer();
+  Drain();
+  if (fFd <= STDERR_FILENO)
+    return;
+  auto tbeg = ScNow();
+  if (::fdatasync(fFd) < 0 && errno != EINVAL && errno != EROFS)
+    throw SysCallException("FileWriter::Sync"s, "fdatasync"s, fName, errno);
+  fStats.fNSync += 1;
+  fStats.fSyncTime += ScTimeDiff2Double(tbeg, ScNow());
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Rotates the file now
+  \throws SysCallException if the rename or the open of the new file fails
+
+  The buffered data is written to the current file, which is then renamed.
+  Compression and removal of old files is passed to the background thread.
+ */
+
+void FileWriter::Rotate() {
+  WriteBuffer();
+  string rname = RotatedName();
+  if (::rename(fName.c_str(), rname.c_str()) < 0)
+    throw SysCallException("FileWriter::Rotate"s, "rename"s, fName, errno);
+  Drain();
+  fFd.Close();
+  OpenFile();
+  fStats.fNRotate += 1;
+
+  if (!fCompress && fKeep == 0)
+    return; // nothing to do in background
+  {
+    lock_guard<mutex> lock(fMutex);
+    fTodo.push_back(rname);
+  }
+  fCond.notify_one();
+  if (!fThread.joinable())
+    fThread = thread([this]() { CompressLoop(); });
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Writes the buffered data, without rotation check
+ */
+
+void FileWriter::WriteBuffer() {
+  if (fBuffer.empty())
+    return;
+  if (fpUring) {
+    SubmitBuffer();
+    return;
+  }
+  iovec iov = {fBuffer.data(), fBuffer.size()};
+  WriteIov(&iov, 1);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Hand the buffer to io_uring as write request
+  \throws SysCallException if a request failed
+
+  Waits for a free slot when `iodepth` requests are in flight. The buffer is
+  swapped with the data of the slot, so no data is copied and the buffers
+  are reused.
+ */
+
+void FileWriter::SubmitBuffer() {
+  if (fBuffer.empty())
+    return;
+  auto tbeg = ScNow();
+  Reap(false);
+  while (fNInflight == fSlots.size())
+    Reap(true);
+  size_t islot = 0;
+  while (fSlots[islot].fBusy)
+    islot++;
+
+  Slot& slot = fSlots[islot];
+  slot.fData.swap(fBuffer);
+  fBuffer.clear();
+  slot.fIov = {slot.fData.data(), slot.fData.size()};
+  slot.fOffset = fFileSize;
+  slot.fBusy = true;
+  fFileSize += slot.fData.size();
+  fNInflight += 1;
+  fpUring->PrepWrite(fFd, &slot.fIov, slot.fOffset, islot);
+  fpUring->Submit();
+
+  double dt = ScTimeDiff2Double(tbeg, ScNow());
+  fStats.fNWrite += 1;
+  fStats.fWriteTime += dt;
+  fStats.fWriteMax = max(fStats.fWriteMax, dt);
+  if (fUringErrno != 0)
+    Drain(); // throws
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Handle completed io_uring requests
+  \param wait   if `true` wait for at least one completion
+
+  A partial write is resubmitted for the remainder. The errno of a failed
+  request is kept in fUringErrno, the data of that request is lost.
+ */
+
+void FileWriter::Reap(bool wait) {
+  uint64_t islot = 0;
+  int res = 0;
+  while (fpUring->Reap(islot, res, wait)) {
+    wait = false;
+    Slot& slot = fSlots[islot];
+    if (res > 0 && size_t(res) < slot.fIov.iov_len) {
+      fStats.fNByte += res;
+      slot.fIov.iov_base = static_cast<char*>(slot.fIov.iov_base) + res;
+      slot.fIov.iov_len -= size_t(res);
+      slot.fOffset += uint64_t(res);
+      fpUring->PrepWrite(fFd, &slot.fIov, slot.fOffset, islot);
+      fpUring->Submit();
+      continue;
+    }
+    if (res <= 0)
+      fUringErrno = res < 0 ? -res : EIO;
+    else
+      fStats.fNByte += res;
+    slot.fData.clear();
+    slot.fBusy = false;
+    fNInflight -= 1;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Wait until all io_uring requests completed
+  \throws SysCallException if a request failed
+ */
+
+void FileWriter::Drain() {
+  if (!fpUring)
+    return;
+  while (fNInflight > 0)
+    Reap(true);
+  if (fUringErrno != 0) {
+    int eno = fUringErrno;
+    fUringErrno = 0;
+    throw SysCallException("FileWriter::Write"s, "io_uring writev"s, fName,
+                           eno);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Writes all `niov` buffers, continues after partial writes
+
+  Clears the buffer afterwards, also when the write failed.
+ */
+
+void FileWriter::WriteIov(iovec* iovs, int niov) {
+  while (niov > 0) {
+    auto tbeg = ScNow();
+    ssize_t nwrite = ::writev(fFd, iovs, niov);
+    double dt = ScTimeDiff2Double(tbeg, ScNow());
+    if (nwrite < 0) {
+      if (errno == EINTR)
+        continue;
+      int eno = errno;
+      fBuffer.clear();
+      throw SysCallException("FileWriter::Write"s, "writev"s, fName, eno);
+    }
+    fStats.fNWrite += 1;
+    fStats.fNByte += nwrite;
+    fFileSize += size_t(nwrite);
+    fStats.fWriteTime += dt;
+    fStats.fWriteMax = max(fStats.fWriteMax, dt);
+
+    // skip the written part
+    size_t nrest = size_t(nwrite);
+    while (niov > 0 && nrest >= iovs->iov_len) {
+      nrest -= iovs->iov_len;
+      iovs++;
+      niov--;
+    }
+    if (niov > 0) {
+      iovs->iov_base = static_cast<char*>(iovs->iov_base) + nrest;
+      iovs->iov_len -= nrest;
+    }
+  }
+  fBuffer.clear();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Creates or truncates the file `fName`
+ */
+
+void FileWriter::OpenFile() {
+  int fd =
+      ::open(fName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0)
+    throw SysCallException("FileWriter::OpenFile"s, "open"s, fName, errno);
+  fFd.Set(fd);
+  fFileSize = 0;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the name for the file rotated now
+
+  A counter is appended when a file of that name exists already, which can
+  only happen with several rotations within one second.
+ */
+
+string FileWriter::RotatedName() const {
+  time_t now = ::time(nullptr);
+  tm now_tm;
+  (void)::localtime_r(&now, &now_tm);
+  char buf[32];
+  (void)::strftime(buf, sizeof(buf), "%Y%m%d-%H%M%S", &now_tm);
+  string base = fName + "." + buf;
+  string res = base;
+  for (int i = 1; ::access(res.c_str(), F_OK) == 0 ||
+                  ::access((res + ".gz").c_str(), F_OK) == 0;
+       i++)
+    res = base + "." + to_string(i);
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Determine next periodic rotation, aligned to the wall-clock
+ */
+
+void FileWriter::ScheduleRotation() {
+  double now = 1.e-9 * double(ScTimePoint2Nsec(ScNow()));
+  double next = (floor(now / fRotPeriod) + 1.) * fRotPeriod;
+  fNextRotate = Nsec2ScTimePoint(long(next * 1.e9));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Stop compressor thread, queued files stay uncompressed
+
+  A compression in progress is abandoned, a final Prune() also counts the
+  uncompressed files. The thread is raised to the
+  normal scheduling policy, so the join doesn't depend on idle CPU time.
+ */
+
+void FileWriter::StopCompressor() {
+  {
+    lock_guard<mutex> lock(fMutex);
+    fStop = true;
+  }
+  fCond.notify_one();
+  if (fThread.joinable()) {
+    sched_param param{};
+    (void)::pthread_setschedparam(fThread.native_handle(), SCHED_OTHER,
+                                  &param);
+    fThread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief The loop of the compressor thread
+ */
+
+void FileWriter::CompressLoop() {
+  SetPThreadName("Cbm:filerot");
+  sched_param param{};
+  (void)::pthread_setschedparam(::pthread_self(), SCHED_IDLE, &param);
+
+  while (true) {
+    string fname;
+    {
+      unique_lock<mutex> lock(fMutex);
+      fCond.wait(lock, [this]() { return fStop || !fTodo.empty(); });
+      if (fStop) {
+        fTodo.clear(); // left uncompressed, but subject to pruning
+      } else {
+        fname = move(fTodo.front());
+        fTodo.pop_front();
+      }
+    }
+    if (!fname.empty() && fCompress && !Compress(fname) && !fStop)
+      fNCompressErr += 1;
+    if (fKeep > 0)
+      Prune();
+    if (fname.empty())
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Compress `fname` to `fname.gz` and remove `fname`
+  \returns `false` on failure or stop, `fname` is kept then
+
+  The compressed data is written to a temporary file which is renamed when
+  complete, so an incomplete `.gz` file is never visible. The compression
+  is abandoned when StopCompressor() was called.
+ */
+
+bool FileWriter::Compress(const string& fname) {
+  string zname = fname + ".gz";
+  string tname = zname + ".tmp";
+  FileDescriptor ifd;
+  ifd.Set(::open(fname.c_str(), O_RDONLY | O_CLOEXEC));
+  if (ifd < 0)
+    return false;
+  gzFile zfile = ::gzopen(tname.c_str(), "wb");
+  if (!zfile)
+    return false;
+
+  bool ok = true;
+  string buf(kCompressChunk, '\0');
+  while (ok && !fStop) {
+    ssize_t nread = ::read(ifd, buf.data(), buf.size());
+    if (nread < 0 && errno == EINTR)
+      continue;
+    if (nread <= 0) {
+      ok = nread == 0;
+      break;
+    }
+    ok = ::gzwrite(zfile, buf.data(), unsigned(nread)) == int(nread);
+  }
+  ok = ::gzclose(zfile) == Z_OK && ok && !fStop;
+  if (ok && ::rename(tname.c_str(), zname.c_str()) == 0) {
+    (void)::unlink(fname.c_str());
+    return true;
+  }
+  (void)::unlink(tname.c_str());
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Remove the oldest rotated files, keep `fKeep` of them
+
+  Rotated files still queued in `fTodo` are neither counted nor removed,
+  they are not yet compressed and will be handled in a later call.
+ */
+
+void FileWriter::Prune() {
+  size_t pos = fName.rfind('/');
+  string dname = pos == string::npos ? "./"s : fName.substr(0, pos + 1);
+  string prefix = (pos == string::npos ? fName : fName.substr(pos + 1)) + ".";
+
+  vector<string> todo; // base names of queued files
+  {
+    lock_guard<mutex> lock(fMutex);
+    for (const auto& tname : fTodo)
+      todo.push_back(tname.substr(pos == string::npos ? 0 : pos + 1));
+  }
+
+  DIR* dir = ::opendir(dname.c_str());
+  if (!dir)
+    return;
+  vector<pair<pair<string, long>, string>> rotated; // (stamp, count), name
+  while (dirent* ent = ::readdir(dir)) {
+    string_view name(ent->d_name);
+    // match <prefix>yyyymmdd-hhmmss[.n][.gz], skip temporary files
+    if (name.substr(0, prefix.size()) != prefix)
+      continue;
+    string_view stamp = name.substr(prefix.size());
+    if (stamp.size() < 15 || stamp[8] != '-' ||
+        stamp.find_first_not_of("0123456789-") < 15 ||
+        name.substr(name.size() - 4) == ".tmp")
+      continue;
+    if (find(todo.begin(), todo.end(), name) != todo.end())
+      continue;
+    long count = 0; // counter of rotations within a second
+    if (stamp.size() > 16 && stamp[15] == '.')
+      count = ::strtol(string(stamp.substr(16)).c_str(), nullptr, 10);
+    rotated.push_back({{string(stamp.substr(0, 15)), count}, string(name)});
+  }
+  (void)::closedir(dir);
+
+  if (rotated.size() <= size_t(fKeep))
+    return;
+  sort(rotated.begin(), rotated.end()); // oldest first
+  for (size_t i = 0; i + size_t(fKeep) < rotated.size(); i++)
+    (void)::unlink((dname + rotated[i].second).c_str());
+}
+
+} // end namespace cbm
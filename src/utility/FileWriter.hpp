@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_FileWriter
+#define included_Cbm_FileWriter 1
+
+#include "ChronoDefs.hpp"
+#include "FileDescriptor.hpp"
+#include "FileUring.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+namespace cbm {
+using namespace std;
+
+class SinkOptions; // forward declaration
+
+class FileWriter {
+public:
+  struct Stats {
+    long fNWrite{0};       //!< # of write system calls
+    long fNByte{0};        //!< # of written bytes
+    double fWriteTime{0.}; //!< total time in write calls (in s)
+    double fWriteMax{0.};  //!< longest write call (in s)
+    long fNSync{0};        //!< # of fdatasync calls
+    double fSyncTime{0.};  //!< total time in fdatasync calls (in s)
+    long fNRotate{0};      //!< # of rotations
+    long fNCompressErr{0}; //!< # of failed compressions
+  };
+
+  FileWriter(const string& fname, size_t bufsize);
+  virtual ~FileWriter();
+
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+
+  const string& Name() const;
+  size_t Buffered() const;
+  bool Async() const;
+  void Configure(const SinkOptions& opts);
+  void Write(string_view data);
+  void Flush();
+  void Sync();
+  void Rotate();
+  Stats Statistics() const;
+  void ResetStatistics();
+
+  static const vector<string> kOptionKeys; //!< keys used by Configure()
+
+private:
+  struct Slot {
+    string fData{};      //!< data of the request, swapped with fBuffer
+    iovec fIov{};        //!< not yet written part of fData
+    uint64_t fOffset{0}; //!< file offset of fIov
+    bool fBusy{false};   //!< request in flight
+  };
+
+  void WriteBuffer();
+  void SubmitBuffer();
+  void Reap(bool wait);
+  void Drain();
+  void WriteIov(iovec* iovs, int niov);
+  void OpenFile();
+  string RotatedName() const;
+  void ScheduleRotation();
+  void StopCompressor();
+  void CompressLoop();
+  bool Compress(const string& fname);
+  void Prune();
+
+private:
+  string fName;                    //!< file name
+  FileDescriptor fFd;              //!< fd of file, or of stdout/stderr
+  size_t fBufSize;                 //!< buffer size, a full buffer is written
+  string fBuffer{};                //!< data not yet written
+  Stats fStats{};                  //!< statistics
+  size_t fFileSize{0};             //!< bytes written to current file
+  size_t fRotSize{0};              //!< rotate when file exceeds, 0 if off
+  double fRotPeriod{0.};           //!< rotation period (in s), 0 if off
+  sctime_point fNextRotate{};      //!< time of next periodic rotation
+  long fKeep{0};                   //!< # of rotated files to keep, 0 for all
+  bool fCompress{true};            //!< gzip rotated files
+  thread fThread{};                //!< compressor thread, started on demand
+  mutex fMutex{};                  //!< mutex for fTodo and fStop
+  condition_variable fCond{};      //!< signals fTodo or fStop change
+  deque<string> fTodo{};           //!< rotated files to compress and prune
+  atomic<bool> fStop{false};       //!< signals compressor thread rundown
+  atomic<long> fNCompressErr{0};   //!< # of failed compressions
+  unique_ptr<FileUring> fpUring{}; //!< io_uring, only for `io=uring`
+  vector<Slot> fSlots{};           //!< io_uring request slots
+  size_t fNInflight{0};            //!< # of busy slots
+  int fUringErrno{0};              //!< errno of a failed request
+};
+
+} // end namespace cbm
+
+#include "FileWriter.ipp"
+
+#endif
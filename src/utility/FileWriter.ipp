@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the file name
+
+inline const string& FileWriter::Name() const { return fName; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the number of buffered, not yet written bytes
+
+inline size_t FileWriter::Buffered() const { return fBuffer.size(); }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` if the io_uring backend is used
+
+inline bool FileWriter::Async() const { return bool(fpUring); }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the statistics since the last ResetStatistics()
+
+inline FileWriter::Stats FileWriter::Statistics() const {
+  Stats res = fStats;
+  res.fNCompressErr = fNCompressErr.load();
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Resets the statistics
+
+inline void FileWriter::ResetStatistics() {
+  fStats = Stats();
+  fNCompressErr = 0;
+}
+
+} // end namespace cbm
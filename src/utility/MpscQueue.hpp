@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_MpscQueue
+#define included_Cbm_MpscQueue 1
+
+#include <atomic>
+#include <vector>
+
+namespace cbm {
+using namespace std;
+
+template <typename T> class MpscQueue {
+public:
+  MpscQueue();
+  ~MpscQueue();
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  void Push(T&& val);
+  bool Pop(T& val);
+  size_t PopAll(vector<T>& vec);
+  bool Empty() const;
+  template <typename F> size_t ForEach(F&& func) const;
+
+private:
+  struct Node {
+    atomic<Node*> fNext{nullptr}; //!< next (newer) node, or next free node
+    T fValue{};                   //!< payload, moved out by Pop()
+  };
+
+  struct NodeCache {
+    ~NodeCache();
+    Node* fFirst{nullptr}; //!< first free node of the thread
+  };
+
+  Node* NewNode();
+  void Recycle(Node* node);
+  void PublishFree();
+  static void DeleteList(Node* node);
+  static NodeCache& ThreadCache();
+
+  alignas(64) atomic<Node*> fHead;          //!< newest node, producers exchange
+  alignas(64) Node* fTail;                  //!< consumed dummy, consumer only
+  Node* fRecFirst{nullptr};                 //!< recycled nodes, consumer only
+  Node* fRecLast{nullptr};                  //!< last recycled node
+  size_t fNRec{0};                          //!< # of recycled nodes
+  alignas(64) atomic<Node*> fFree{nullptr}; //!< free nodes for producers
+};
+
+} // end namespace cbm
+
+#include "MpscQueue.ipp"
+
+#endif
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include <thread>
+
+namespace cbm {
+// some constants
+static const size_t kMpscRecycleBatch = 64; // recycled nodes per publish
+
+/*! \class MpscQueue
+  \brief Lock-free multi producer single consumer FIFO queue
+
+  A linked list of nodes after D. Vyukov. Producers append with a single
+  atomic exchange of the head pointer and a store into the link of the
+  previous node, so Push() never waits for other producers or the consumer.
+  The consumer follows the links from a dummy node, the node of a popped
+  value becomes the new dummy.
+
+  Between the exchange and the link store of a producer the list is
+  transiently broken. Pop() waits in this case until the link is completed,
+  so a value which was pushed before the Pop() started is always returned.
+
+  The nodes are recycled, so in steady state Push() and Pop() don't
+  allocate. The consumer collects the nodes of popped values and publishes
+  them in batches to a free list with a single compare-exchange. A producer
+  takes the whole free list with one exchange into a thread-local cache and
+  uses its nodes one by one. Taking the whole list, instead of single
+  nodes, avoids the ABA problem of a lock-free stack. Only when cache and
+  free list are empty a new node is allocated.
+
+  Push() can be called concurrently from any thread, Pop(), PopAll(),
+  Empty() and ForEach() only from one consumer thread. `T` must be default
+  constructible.
+*/
+
+//-----------------------------------------------------------------------------
+//! \brief Constructor, creates the initial dummy node
+
+template <typename T> inline MpscQueue<T>::MpscQueue() {
+  fTail = new Node;
+  fHead.store(fTail, memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Destructor, discards all values still queued
+
+template <typename T> inline MpscQueue<T>::~MpscQueue() {
+  DeleteList(fTail);
+  DeleteList(fRecFirst);
+  DeleteList(fFree.load(memory_order_acquire));
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Append a value, can be called from any thread
+
+template <typename T> inline void MpscQueue<T>::Push(T&& val) {
+  Node* node = NewNode();
+  node->fValue = move(val);
+  Node* prev = fHead.exchange(node, memory_order_seq_cst);
+  prev->fNext.store(node, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Remove the oldest value, consumer only
+  \param val    is assigned the removed value
+  \returns `false` if the queue was empty
+ */
+
+template <typename T> inline bool MpscQueue<T>::Pop(T& val) {
+  Node* next = fTail->fNext.load(memory_order_acquire);
+  while (!next) {
+    if (fHead.load(memory_order_seq_cst) == fTail)
+      return false;
+    this_thread::yield(); // a producer is between exchange and link
+    next = fTail->fNext.load(memory_order_acquire);
+  }
+  // advance fTail before the old dummy is freed, so ForEach() called from a
+  // signal handler in the consumer thread never starts from a freed node
+  Node* prev = fTail;
+  fTail = next;
+  atomic_signal_fence(memory_order_seq_cst);
+  val = move(next->fValue);
+  Recycle(prev);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Remove all values queued when the call started, consumer only
+  \param vec    vector to which the removed values are appended
+  \returns number of removed values
+
+  Values pushed while the call runs are left for the next call, so the
+  amount of work per call is bounded even when producers push faster than
+  the consumer removes.
+ */
+
+template <typename T> inline size_t MpscQueue<T>::PopAll(vector<T>& vec) {
+  Node* last = fHead.load(memory_order_seq_cst);
+  size_t nval = 0;
+  T val;
+  while (fTail != last && Pop(val)) {
+    vec.push_back(move(val));
+    nval += 1;
+  }
+  PublishFree();
+  return nval;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` if no value is queued, consumer only
+
+template <typename T> inline bool MpscQueue<T>::Empty() const {
+  return fHead.load(memory_order_seq_cst) == fTail;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Calls `func` for each queued value without removing it
+  \param func   called with a `const T&` for each value, oldest first
+  \returns number of visited values
+
+  Consumer only, the consumer must not Pop() concurrently. Visits at most
+  the values queued when the call started and stops at a link which is not
+  yet completed, so it never waits. Doesn't allocate, so it can be used in
+  a signal handler, also one which interrupted Pop() in the same thread.
+ */
+
+template <typename T>
+template <typename F>
+inline size_t MpscQueue<T>::ForEach(F&& func) const {
+  Node* last = fHead.load(memory_order_seq_cst);
+  Node* node = fTail;
+  size_t nval = 0;
+  while (node != last) {
+    node = node->fNext.load(memory_order_acquire);
+    if (!node)
+      break;
+    func(static_cast<const T&>(node->fValue));
+    nval += 1;
+  }
+  return nval;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns a free node, producer side
+
+  Takes the node from the thread-local cache, refills the cache from the
+  free list when empty, and allocates only when both are empty.
+ */
+
+template <typename T>
+inline typename MpscQueue<T>::Node* MpscQueue<T>::NewNode() {
+  NodeCache& cache = ThreadCache();
+  if (!cache.fFirst && fFree.load(memory_order_relaxed))
+    cache.fFirst = fFree.exchange(nullptr, memory_order_acquire);
+  Node* node = cache.fFirst;
+  if (!node)
+    return new Node;
+  cache.fFirst = node->fNext.load(memory_order_relaxed);
+  node->fNext.store(nullptr, memory_order_relaxed);
+  return node;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Keeps the node of a popped value for reuse, consumer only
+
+  The nodes are published with PublishFree() when a batch is complete.
+ */
+
+template <typename T> inline void MpscQueue<T>::Recycle(Node* node) {
+  node->fNext.store(fRecFirst, memory_order_relaxed);
+  if (!fRecFirst)
+    fRecLast = node;
+  fRecFirst = node;
+  if (++fNRec >= kMpscRecycleBatch)
+    PublishFree();
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Moves the recycled nodes to the free list, consumer only
+
+  Only the consumer pushes to the free list, producers only take the whole
+  list, so the compare-exchange is free of ABA problems.
+ */
+
+template <typename T> inline void MpscQueue<T>::PublishFree() {
+  if (!fRecFirst)
+    return;
+  Node* top = fFree.load(memory_order_relaxed);
+  do {
+    fRecLast->fNext.store(top, memory_order_relaxed);
+  } while (!fFree.compare_exchange_weak(top, fRecFirst, memory_order_release,
+                                        memory_order_relaxed));
+  fRecFirst = nullptr;
+  fRecLast = nullptr;
+  fNRec = 0;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Deletes a list of nodes linked with `fNext`
+
+template <typename T> inline void MpscQueue<T>::DeleteList(Node* node) {
+  while (node) {
+    Node* next = node->fNext.load(memory_order_relaxed);
+    delete node;
+    node = next;
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the free node cache of the calling thread
+
+  Shared by all queues with the same `T`, the nodes are interchangeable.
+ */
+
+template <typename T>
+inline typename MpscQueue<T>::NodeCache& MpscQueue<T>::ThreadCache() {
+  static thread_local NodeCache cache;
+  return cache;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Destructor, deletes the cached nodes at thread exit
+
+template <typename T> inline MpscQueue<T>::NodeCache::~NodeCache() {
+  DeleteList(fFirst);
+}
+
+} // end namespace cbm
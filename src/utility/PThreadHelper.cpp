@@ -9,6 +9,10 @@
 namespace cbm {
 using namespace std;
 
+// thread name cache of the calling thread, see PThreadName()
+static thread_local string tThreadName;
+static thread_local bool tThreadNameValid = false;
+
 //------------------------------------------------------------------------------
 /*!
   \defgroup PThreadHelper Helper functions for thread handling
@@ -39,19 +43,32 @@ void SetPThreadName(const string& tname) {
   if (tname16.length() > 16)
     tname16.resize(16);
   pthread_setname_np(pthread_self(), tname16.c_str());
+  tThreadNameValid = false;
 }
 
 //-----------------------------------------------------------------------------
 /*!
   \brief Returns the thread name set via SetPThreadName()
   \ingroup PThreadHelper
+
+  The name is retrieved from the kernel only at the first call in a thread
+  and after SetPThreadName(), otherwise a per-thread cached copy is returned.
+  Since the name has at most 15 characters the returned `string` never
+  allocates.
+
+  \note A name changed for the calling thread by other means than
+    SetPThreadName() is not seen.
 */
 
 string PThreadName() {
-  // Note: the kernel limit is 16 char, see TASK_COMM_LEN
-  char tname[17] = {0};
-  (void)::pthread_getname_np(pthread_self(), &tname[0], sizeof(tname) - 1);
-  return string(tname);
+  if (!tThreadNameValid) {
+    // Note: the kernel limit is 16 char, see TASK_COMM_LEN
+    char tname[17] = {0};
+    (void)::pthread_getname_np(pthread_self(), &tname[0], sizeof(tname) - 1);
+    tThreadName = tname;
+    tThreadNameValid = true;
+  }
+  return tThreadName;
 }
 
 } // end namespace cbm
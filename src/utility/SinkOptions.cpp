@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#include "SinkOptions.hpp"
+
+#include "Exception.hpp"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+
+#include <stdlib.h>
+
+namespace cbm {
+using namespace std;
+
+/*! \class SinkOptions
+  \brief Splits a sink path into path and a `key=value` option list
+
+  Sink paths, as given to Monitor::OpenSink() or Logger::OpenSink() after the
+  `proto:` part, can carry options in an URL query like syntax
+  \code
+    path?key1=value1&key2=value2&key3
+  \endcode
+  Everything up to the first '?' is the path, the remainder is a list of
+  options separated by '&'. An option without '=' is treated as boolean
+  `true`. The typed getters String(), Long(), Size(), Double() and Bool()
+  return a default value when the option is not given.
+ */
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param spec  sink path with optional option list
+  \throws Exception if an option has an empty key
+ */
+
+SinkOptions::SinkOptions(const string& spec) {
+  auto pos = spec.find('?');
+  fPath = spec.substr(0, pos);
+  if (pos == string::npos)
+    return;
+
+  size_t pbeg = pos + 1;
+  while (pbeg <= spec.size()) {
+    size_t pend = spec.find('&', pbeg);
+    if (pend == string::npos)
+      pend = spec.size();
+    string keyval = spec.substr(pbeg, pend - pbeg);
+    pbeg = pend + 1;
+    if (keyval.empty())
+      continue;
+    size_t pdel = keyval.find('=');
+    if (pdel == 0)
+      throw Exception(
+          fmt::format("SinkOptions::ctor: empty key in '{}'", spec));
+    if (pdel == string::npos)
+      fOptions.emplace_back(keyval, "true");
+    else
+      fOptions.emplace_back(keyval.substr(0, pdel), keyval.substr(pdel + 1));
+  }
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns option `key` as string, or `def` if not given
+ */
+
+string SinkOptions::String(const string& key, const string& def) const {
+  auto pval = Find(key);
+  return pval ? *pval : def;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns option `key` as integer, or `def` if not given
+  \throws Exception if the value is not a valid integer
+ */
+
+long SinkOptions::Long(const string& key, long def) const {
+  auto pval = Find(key);
+  if (!pval)
+    return def;
+  char* pend = nullptr;
+  long res = ::strtol(pval->c_str(), &pend, 10);
+  if (pval->empty() || *pend != '\0')
+    throw Exception(fmt::format("SinkOptions::Long: invalid value '{}={}'",
+                                key, *pval));
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns option `key` as byte size, or `def` if not given
+  \throws Exception if the value is not a valid size
+
+  The value is a non-negative integer with an optional suffix `k`, `M` or `G`
+  for multiples of 1000, 1000000 and 1000000000, e.g. `2M`.
+ */
+
+size_t SinkOptions::Size(const string& key, size_t def) const {
+  auto pval = Find(key);
+  if (!pval)
+    return def;
+  char* pend = nullptr;
+  long res = ::strtol(pval->c_str(), &pend, 10);
+  long mult = 1;
+  if (*pend == 'k') {
+    mult = 1000;
+    pend += 1;
+  } else if (*pend == 'M') {
+    mult = 1000000;
+    pend += 1;
+  } else if (*pend == 'G') {
+    mult = 1000000000;
+    pend += 1;
+  }
+  if (pval->empty() || *pend != '\0' || res < 0)
+    throw Exception(fmt::format("SinkOptions::Size: invalid value '{}={}'",
+                                key, *pval));
+  return size_t(res * mult);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns option `key` as floating point value, or `def` if not given
+  \throws Exception if the value is not a valid number
+ */
+
+double SinkOptions::Double(const string& key, double def) const {
+  auto pval = Find(key);
+  if (!pval)
+    return def;
+  char* pend = nullptr;
+  double res = ::strtod(pval->c_str(), &pend);
+  if (pval->empty() || *pend != '\0')
+    throw Exception(fmt::format("SinkOptions::Double: invalid value '{}={}'",
+                                key, *pval));
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns option `key` as boolean, or `def` if not given
+  \throws Exception if the value is not one of true/false/yes/no/1/0
+ */
+
+bool SinkOptions::Bool(const string& key, bool def) const {
+  auto pval = Find(key);
+  if (!pval)
+    return def;
+  if (*pval == "true" || *pval == "yes" || *pval == "1")
+    return true;
+  if (*pval == "false" || *pval == "no" || *pval == "0")
+    return false;
+  throw Exception(
+      fmt::format("SinkOptions::Bool: invalid value '{}={}'", key, *pval));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Checks that only supported options were given
+  \param where  context for the error message, usually class and method
+  \param keys   list of supported option keys
+  \throws Exception if an option not in `keys` was given
+ */
+
+void SinkOptions::Check(const string& where,
+                        const vector<string>& keys) const {
+  for (auto& kv : fOptions)
+    if (find(keys.begin(), keys.end(), kv.first) == keys.end())
+      throw Exception(
+          fmt::format("{}: unknown option '{}' for '{}'", where, kv.first,
+                      fPath));
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns pointer to value of option `key`, or `nullptr`
+
+  If an option is given several times the last one wins.
+ */
+
+const string* SinkOptions::Find(const string& key) const {
+  for (auto it = fOptions.rbegin(); it != fOptions.rend(); ++it)
+    if (it->first == key)
+      return &it->second;
+  return nullptr;
+}
+
+} // end namespace cbm
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+#ifndef included_Cbm_SinkOptions
+#define included_Cbm_SinkOptions 1
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cbm {
+using namespace std;
+
+class SinkOptions {
+public:
+  SinkOptions() = default;
+  explicit SinkOptions(const string& spec);
+
+  const string& Path() const;
+  bool Has(const string& key) const;
+  string String(const string& key, const string& def) const;
+  long Long(const string& key, long def) const;
+  size_t Size(const string& key, size_t def) const;
+  double Double(const string& key, double def) const;
+  bool Bool(const string& key, bool def) const;
+
+  void Check(const string& where, const vector<string>& keys) const;
+
+private:
+  const string* Find(const string& key) const;
+
+private:
+  string fPath{""};                      //!< path part of spec
+  vector<pair<string, string>> fOptions; //!< key/value list
+};
+
+} // end namespace cbm
+
+#include "SinkOptions.ipp"
+
+#endif
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2026 GSI Helmholtzzentrum für Schwerionenforschung
+// Original author: Walter F.J. Mueller <w.f.j.mueller@gsi.de>
+
+namespace cbm {
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//! \brief Returns the path part of the spec, with options stripped
+
+inline const string& SinkOptions::Path() const { return fPath; }
+
+//-----------------------------------------------------------------------------
+//! \brief Returns `true` if option `key` was given
+
+inline bool SinkOptions::Has(const string& key) const {
+  return Find(key) != nullptr;
+}
+
+} // end namespace cbm